@@ -0,0 +1,76 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridAnchorIndex.h"
+
+void FGridAnchorIndex::Build(const FGridBitboard& Board, int32 Plane, bool bFreeWhenSet, FIntPoint InFootprint)
+{
+	const int32 Width = Board.GetWidth();
+	const int32 Height = Board.GetHeight();
+	const int32 WordsPerRow = Board.GetWordsPerRow();
+	Footprint = InFootprint;
+	Anchors.Init(FIntPoint(Width, Height), 1);
+	if (Footprint.X <= 0 || Footprint.Y <= 0 || Footprint.X > Width || Footprint.Y > Height) return;
+
+	const int32 TailBits = Width & 63;
+	TArray<uint64, TInlineAllocator<8>> Free;
+	Free.SetNumUninitialized(WordsPerRow);
+
+	// Pass 1: horizontal erosion of every row (bit X set = cells [X, X + W) free), written into the anchor rows
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const uint64* Source = Board.GetRow(Plane, Y);
+		for (int32 W = 0; W < WordsPerRow; ++W) { Free[W] = bFreeWhenSet ? Source[W] : ~Source[W]; }
+		if (TailBits != 0) { Free[WordsPerRow - 1] &= FGridBitboard::MakeSpanMask(0, TailBits); }
+
+		// Shift by 1..W-1 toward bit 0, pulling bits in from the next word (zeros past the row end clear the last W-1 anchors)
+		uint64* Row = Anchors.GetRow(0, Y);
+		for (int32 W = 0; W < WordsPerRow; ++W) { Row[W] = Free[W]; }
+		for (int32 Shift = 1; Shift < Footprint.X; ++Shift)
+		{
+			const int32 WordShift = Shift >> 6;
+			const int32 BitShift = Shift & 63;
+			for (int32 W = 0; W < WordsPerRow; ++W)
+			{
+				const uint64 Lo = (W + WordShift < WordsPerRow) ? Free[W + WordShift] : 0ull;
+				const uint64 Hi = (W + WordShift + 1 < WordsPerRow) ? Free[W + WordShift + 1] : 0ull;
+				Row[W] &= BitShift == 0 ? Lo : ((Lo >> BitShift) | (Hi << (64 - BitShift)));
+			}
+		}
+	}
+
+	// Pass 2: vertical erosion in place, top-down (row Y only reads rows below it, which are still horizontal-only)
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		uint64* Row = Anchors.GetRow(0, Y);
+		if (Y + Footprint.Y > Height)
+		{
+			for (int32 W = 0; W < WordsPerRow; ++W) { Row[W] = 0; }
+			continue;
+		}
+		for (int32 DY = 1; DY < Footprint.Y; ++DY)
+		{
+			const uint64* Below = Anchors.GetRow(0, Y + DY);
+			for (int32 W = 0; W < WordsPerRow; ++W) { Row[W] &= Below[W]; }
+		}
+	}
+}
+
+void FGridAnchorIndex::Reset()
+{
+	Anchors.Reset();
+	Footprint = FIntPoint::ZeroValue;
+}
+
+void FGridAnchorIndex::RemoveRect(FIntPoint Start, FIntPoint Size)
+{
+	if (!IsBuilt() || Size.X <= 0 || Size.Y <= 0) return;
+
+	// Anchors whose footprint overlaps the rect, clipped to the grid
+	const int32 MinX = FMath::Max(Start.X - Footprint.X + 1, 0);
+	const int32 MinY = FMath::Max(Start.Y - Footprint.Y + 1, 0);
+	const int32 MaxX = FMath::Min(Start.X + Size.X, Anchors.GetWidth());
+	const int32 MaxY = FMath::Min(Start.Y + Size.Y, Anchors.GetHeight());
+	if (MinX >= MaxX || MinY >= MaxY) return;
+
+	Anchors.SetRect(0, MinX, MinY, MaxX - MinX, MaxY - MinY, false);
+}
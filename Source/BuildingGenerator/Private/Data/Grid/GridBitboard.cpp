@@ -0,0 +1,203 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridBitboard.h"
+
+void FGridBitboard::Init(FIntPoint InSize, int32 InNumPlanes)
+{
+	Width = FMath::Max(InSize.X, 0);
+	Height = FMath::Max(InSize.Y, 0);
+	WordsPerRow = (Width + 63) >> 6;
+	NumPlanes = InNumPlanes;
+	PlaneStride = Align(WordsPerRow * Height, PlaneAlignWords);
+
+	Words.Reset();
+	Words.SetNumZeroed(PlaneStride * NumPlanes);
+}
+
+void FGridBitboard::Reset()
+{
+	Width = Height = WordsPerRow = NumPlanes = PlaneStride = 0;
+	Words.Empty();
+}
+
+#pragma region Rect Operations
+bool FGridBitboard::IsRectSet(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY) const
+{
+	checkSlow(X >= 0 && Y >= 0 && X + SizeX <= Width && Y + SizeY <= Height);
+
+	for (int32 Row = Y; Row < Y + SizeY; ++Row)
+	{
+		if (!ForEachSpanWord(GetRow(Plane, Row), X, SizeX, [](uint64 Word, uint64 Mask) { return (Word & Mask) == Mask; }))
+			return false;
+	}
+	return true;
+}
+
+bool FGridBitboard::IsRectClear(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY) const
+{
+	checkSlow(X >= 0 && Y >= 0 && X + SizeX <= Width && Y + SizeY <= Height);
+
+	for (int32 Row = Y; Row < Y + SizeY; ++Row)
+	{
+		if (!ForEachSpanWord(GetRow(Plane, Row), X, SizeX, [](uint64 Word, uint64 Mask) { return (Word & Mask) == 0; }))
+			return false;
+	}
+	return true;
+}
+
+void FGridBitboard::SetRect(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY, bool bValue)
+{
+	checkSlow(X >= 0 && Y >= 0 && X + SizeX <= Width && Y + SizeY <= Height);
+	if (SizeX <= 0 || SizeY <= 0) return;
+
+	const int32 FirstWord = X >> 6;
+	const int32 LastWord = (X + SizeX - 1) >> 6;
+
+	for (int32 Row = Y; Row < Y + SizeY; ++Row)
+	{
+		uint64* RowWords = GetRow(Plane, Row);
+		for (int32 W = FirstWord; W <= LastWord; ++W)
+		{
+			const int32 Lo = (W == FirstWord) ? (X & 63) : 0;
+			const int32 Hi = (W == LastWord) ? ((X + SizeX - 1) & 63) + 1 : 64;
+			const uint64 Mask = MakeSpanMask(Lo, Hi - Lo);
+			RowWords[W] = bValue ? (RowWords[W] | Mask) : (RowWords[W] & ~Mask);
+		}
+	}
+}
+
+void FGridBitboard::SetRectType(int32 X, int32 Y, int32 SizeX, int32 SizeY, EGridCellType NewType)
+{
+	for (int32 Plane = 0; Plane < NumCellTypePlanes; ++Plane)
+	{
+		SetRect(Plane, X, Y, SizeX, SizeY, Plane == PlaneOf(NewType));
+	}
+}
+#pragma endregion
+
+#pragma region Plane Operations
+void FGridBitboard::FillPlane(int32 Plane, bool bValue)
+{
+	if (!bValue)
+	{
+		FMemory::Memzero(GetRow(Plane, 0), sizeof(uint64) * WordsPerRow * Height);
+		return;
+	}
+
+	// Full rows, with the tail bits of the last word kept clear
+	const int32 TailBits = Width & 63;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		uint64* Row = GetRow(Plane, Y);
+		for (int32 W = 0; W < WordsPerRow; ++W) { Row[W] = ~0ull; }
+		if (TailBits != 0) { Row[WordsPerRow - 1] = MakeSpanMask(0, TailBits); }
+	}
+}
+
+void FGridBitboard::MovePlaneInto(int32 SrcPlane, int32 DstPlane)
+{
+	if (SrcPlane == DstPlane) return;
+
+	uint64* Src = GetRow(SrcPlane, 0);
+	uint64* Dst = GetRow(DstPlane, 0);
+	const int32 PlaneWords = PlaneStride;
+	for (int32 i = 0; i < PlaneWords; ++i)
+	{
+		Dst[i] |= Src[i];
+		Src[i] = 0;
+	}
+}
+
+int32 FGridBitboard::CountSet(int32 Plane) const
+{
+	const uint64* PlaneWords = GetRow(Plane, 0);
+	const int32 NumWords = PlaneStride;
+
+	int32 Count = 0;
+	for (int32 i = 0; i < NumWords; ++i) { Count += FMath::CountBits(PlaneWords[i]); }
+	return Count;
+}
+
+int32 FGridBitboard::CopyPlaneUnion(int32 DstPlane, const FGridBitboard& Source, TConstArrayView<int32> SourcePlanes, bool bInvert)
+{
+	check(Source.Width == Width && Source.Height == Height);
+
+	// Word-wise OR of the source planes, with the tail bits of the last word kept clear
+	const int32 TailBits = Width & 63;
+	int32 Count = 0;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		uint64* Dst = GetRow(DstPlane, Y);
+		for (int32 W = 0; W < WordsPerRow; ++W)
+		{
+			uint64 Word = 0;
+			for (int32 Plane : SourcePlanes) { Word |= Source.GetRow(Plane, Y)[W]; }
+			if (bInvert) { Word = ~Word; }
+			if (TailBits != 0 && W == WordsPerRow - 1) { Word &= MakeSpanMask(0, TailBits); }
+			Dst[W] = Word;
+			Count += FMath::CountBits(Word);
+		}
+	}
+	return Count;
+}
+
+void FGridBitboard::BuildFromCells(const TArray<EGridCellType>& Cells)
+{
+	check(Cells.Num() == Width * Height);
+
+	for (int32 Plane = 0; Plane < NumCellTypePlanes; ++Plane) { FillPlane(Plane, false); }
+
+	const EGridCellType* Cell = Cells.GetData();
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X, ++Cell)
+		{
+			GetRow(PlaneOf(*Cell), Y)[X >> 6] |= 1ull << (X & 63);
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Cross-Plane Operations
+namespace GridPlaneOps
+{
+	/** Op selected once per call so the word loop stays branch-free (and vectorizable) */
+	template<typename FuncType>
+	FORCEINLINE void Dispatch(EGridPlaneOp Op, FuncType&& Func)
+	{
+		switch (Op)
+		{
+		case EGridPlaneOp::And:		Func([](uint64 A, uint64 B) { return A & B; }); break;
+		case EGridPlaneOp::Or:		Func([](uint64 A, uint64 B) { return A | B; }); break;
+		case EGridPlaneOp::AndNot:	Func([](uint64 A, uint64 B) { return A & ~B; }); break;
+		case EGridPlaneOp::Xor:		Func([](uint64 A, uint64 B) { return A ^ B; }); break;
+		}
+	}
+}
+
+void FGridBitboard::CombinePlanes(int32 DstPlane, int32 PlaneA, int32 PlaneB, EGridPlaneOp Op)
+{
+	// Every op maps zero padding to zero, so whole strides (padding included) are combined
+	const uint64* A = GetRow(PlaneA, 0);
+	const uint64* B = GetRow(PlaneB, 0);
+	uint64* Dst = GetRow(DstPlane, 0);
+	const int32 NumWords = PlaneStride;
+	GridPlaneOps::Dispatch(Op, [&](auto WordOp)
+	{
+		for (int32 i = 0; i < NumWords; ++i) { Dst[i] = WordOp(A[i], B[i]); }
+	});
+}
+
+int32 FGridBitboard::CountCombined(int32 PlaneA, int32 PlaneB, EGridPlaneOp Op) const
+{
+	const uint64* A = GetRow(PlaneA, 0);
+	const uint64* B = GetRow(PlaneB, 0);
+	const int32 NumWords = PlaneStride;
+	int32 Count = 0;
+	GridPlaneOps::Dispatch(Op, [&](auto WordOp)
+	{
+		for (int32 i = 0; i < NumWords; ++i) { Count += FMath::CountBits(WordOp(A[i], B[i])); }
+	});
+	return Count;
+}
+#pragma endregion
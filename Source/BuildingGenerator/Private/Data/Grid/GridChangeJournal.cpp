@@ -0,0 +1,127 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridChangeJournal.h"
+
+void FGridChangeJournal::Reset()
+{
+	Entries.Reset();
+	PrevCells.Reset();
+	Phases.Reset();
+	bRecording = false;
+}
+
+void FGridChangeJournal::BeginPhase(EGridPhase Phase, int32 NumRecords)
+{
+	Phases.Add({ Phase, Entries.Num(), NumRecords });
+	bRecording = true;
+}
+
+void FGridChangeJournal::ContinuePhase(EGridPhase Phase, int32 NumRecords)
+{
+	if (Phases.Num() > 0 && Phases.Last().Phase == Phase) { bRecording = true; return; }
+	BeginPhase(Phase, NumRecords);
+}
+
+int32 FGridChangeJournal::FindLastPhase(EGridPhase Phase) const
+{
+	for (int32 Index = Phases.Num() - 1; Index >= 0; --Index)
+	{
+		if (Phases[Index].Phase == Phase) return Index;
+	}
+	return INDEX_NONE;
+}
+
+int32 FGridChangeJournal::CountChangedCells(int32 PhaseIndex) const
+{
+	int32 Count = 0;
+	for (int32 Index = Phases[PhaseIndex].FirstEntry; Index < Entries.Num(); ++Index)
+	{
+		Count += Entries[Index].Size.X * Entries[Index].Size.Y;
+	}
+	return Count;
+}
+
+#pragma region Recording
+void FGridChangeJournal::RecordUniform(FIntPoint Start, FIntPoint Size, EGridCellType PrevType)
+{
+	if (!bRecording) return;
+	Entries.Add({ Start, Size, PrevType, INDEX_NONE });
+}
+
+void FGridChangeJournal::RecordCells(FIntPoint Start, FIntPoint Size, const FGridChunkStore& Cells)
+{
+	if (!bRecording) return;
+
+	// Uniform rects (the common case) cost one entry and no cell copy
+	const EGridCellType FirstType = Cells.GetCell(Start.X, Start.Y);
+	bool bUniform = true;
+	for (int32 Y = Start.Y; Y < Start.Y + Size.Y && bUniform; ++Y)
+	{
+		for (int32 X = Start.X; X < Start.X + Size.X; ++X)
+		{
+			if (Cells.GetCell(X, Y) != FirstType) { bUniform = false; break; }
+		}
+	}
+	if (bUniform)
+	{
+		Entries.Add({ Start, Size, FirstType, INDEX_NONE });
+		return;
+	}
+
+	const int32 PrevOffset = PrevCells.Num();
+	PrevCells.Reserve(PrevOffset + Size.X * Size.Y);
+	for (int32 Y = Start.Y; Y < Start.Y + Size.Y; ++Y)
+	{
+		for (int32 X = Start.X; X < Start.X + Size.X; ++X) { PrevCells.Add(Cells.GetCell(X, Y)); }
+	}
+	Entries.Add({ Start, Size, FirstType, PrevOffset });
+}
+#pragma endregion
+
+int32 FGridChangeJournal::Rewind(int32 PhaseIndex, TFunctionRef<void(FIntPoint Start, FIntPoint Size, EGridCellType Type)> Restore)
+{
+	check(Phases.IsValidIndex(PhaseIndex));
+	const int32 FirstEntry = Phases[PhaseIndex].FirstEntry;
+
+	// Restores write through the caller's normal path, which must not journal them
+	const bool bWasRecording = bRecording;
+	bRecording = false;
+
+	int32 RestoredCells = 0;
+	for (int32 Index = Entries.Num() - 1; Index >= FirstEntry; --Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		RestoredCells += Entry.Size.X * Entry.Size.Y;
+		if (Entry.PrevOffset == INDEX_NONE)
+		{
+			Restore(Entry.Start, Entry.Size, Entry.PrevType);
+			continue;
+		}
+
+		// Mixed rect: one write per run of equal types along each row
+		const EGridCellType* Prev = PrevCells.GetData() + Entry.PrevOffset;
+		for (int32 Y = 0; Y < Entry.Size.Y; ++Y, Prev += Entry.Size.X)
+		{
+			int32 RunStart = 0;
+			for (int32 X = 1; X <= Entry.Size.X; ++X)
+			{
+				if (X < Entry.Size.X && Prev[X] == Prev[RunStart]) continue;
+				Restore(FIntPoint(Entry.Start.X + RunStart, Entry.Start.Y + Y), FIntPoint(X - RunStart, 1), Prev[RunStart]);
+				RunStart = X;
+			}
+		}
+	}
+
+	// Cell copies are appended in entry order, so the earliest dropped mixed entry marks the new end
+	int32 NewPrevCellsNum = PrevCells.Num();
+	for (int32 Index = FirstEntry; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].PrevOffset != INDEX_NONE) { NewPrevCellsNum = Entries[Index].PrevOffset; break; }
+	}
+	PrevCells.SetNum(NewPrevCellsNum);
+	Entries.SetNum(FirstEntry);
+	Phases.SetNum(PhaseIndex);
+
+	bRecording = bWasRecording && Phases.Num() > 0;
+	return RestoredCells;
+}
@@ -0,0 +1,291 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridChunkStore.h"
+
+// Local offset tables per EGridMemoryLayout: [Layout][Axis][Coord], Axis 0 = X, 1 = Y
+static constexpr uint8 GridLayoutOffsets[3][2][FGridChunkStore::ChunkSize] =
+{
+	// RowMajor: Y * 16 + X
+	{
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		{ 0, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240 }
+	},
+	// Tiled4x4: (TileY * 4 + TileX) * 16 + InnerY * 4 + InnerX
+	{
+		{ 0, 1, 2, 3, 16, 17, 18, 19, 32, 33, 34, 35, 48, 49, 50, 51 },
+		{ 0, 4, 8, 12, 64, 68, 72, 76, 128, 132, 136, 140, 192, 196, 200, 204 }
+	},
+	// Morton: X bits on even positions, Y bits on odd positions
+	{
+		{ 0, 1, 4, 5, 16, 17, 20, 21, 64, 65, 68, 69, 80, 81, 84, 85 },
+		{ 0, 2, 8, 10, 32, 34, 40, 42, 128, 130, 136, 138, 160, 162, 168, 170 }
+	}
+};
+
+void FGridChunkStore::Init(FIntPoint InSize, EGridCellType FillType, EGridMemoryLayout InLayout)
+{
+	Reset();
+
+	Layout = InLayout;
+	LocalXOffsets = GridLayoutOffsets[static_cast<int32>(Layout)][0];
+	LocalYOffsets = GridLayoutOffsets[static_cast<int32>(Layout)][1];
+
+	Size = FIntPoint(FMath::Max(InSize.X, 0), FMath::Max(InSize.Y, 0));
+	ChunksX = (Size.X + ChunkMask) >> ChunkShift;
+	ChunksY = (Size.Y + ChunkMask) >> ChunkShift;
+
+	const int32 NumChunks = ChunksX * ChunksY;
+	UniformTypes.Init(FillType, NumChunks);
+	ChunkSlots.Init(INDEX_NONE, NumChunks);
+	NumElided = NumChunks;
+}
+
+void FGridChunkStore::Reset()
+{
+	Size = FIntPoint::ZeroValue;
+	ChunksX = ChunksY = NumElided = 0;
+	UniformTypes.Empty();
+	ChunkSlots.Empty();
+	SlotCells.Empty();
+	SlotTypeCounts.Empty();
+	FreeSlots.Empty();
+}
+
+SIZE_T FGridChunkStore::GetAllocatedSize() const
+{
+	return UniformTypes.GetAllocatedSize() + ChunkSlots.GetAllocatedSize() + SlotCells.GetAllocatedSize()
+		+ SlotTypeCounts.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+}
+
+#pragma region Cell Access
+void FGridChunkStore::SetCell(int32 X, int32 Y, EGridCellType CellType)
+{
+	const int32 Chunk = ChunkIndexOf(X, Y);
+	int32 Slot = ChunkSlots[Chunk];
+	if (Slot == INDEX_NONE)
+	{
+		if (UniformTypes[Chunk] == CellType) return;
+		Slot = AllocateChunk(Chunk);
+	}
+
+	EGridCellType& Cell = SlotCells[Slot * CellsPerChunk + LocalIndexOf(X, Y)];
+	uint16* Counts = CountsOf(Slot);
+	--Counts[static_cast<int32>(Cell)];
+	++Counts[static_cast<int32>(CellType)];
+	Cell = CellType;
+
+	// Single-cell writes leave elision to the next rect write or ReplaceType (avoids churn on alternating writes)
+}
+#pragma endregion
+
+#pragma region Rect Operations
+void FGridChunkStore::FillRect(int32 X, int32 Y, int32 SizeX, int32 SizeY, EGridCellType CellType)
+{
+	checkSlow(X >= 0 && Y >= 0 && X + SizeX <= Size.X && Y + SizeY <= Size.Y);
+	if (SizeX <= 0 || SizeY <= 0) return;
+
+	const int32 MaxX = X + SizeX;
+	const int32 MaxY = Y + SizeY;
+
+	for (int32 ChunkY = Y >> ChunkShift; ChunkY <= (MaxY - 1) >> ChunkShift; ++ChunkY)
+	{
+		for (int32 ChunkX = X >> ChunkShift; ChunkX <= (MaxX - 1) >> ChunkShift; ++ChunkX)
+		{
+			const int32 Chunk = ChunkY * ChunksX + ChunkX;
+
+			// Rect overlap with this chunk's in-grid cells
+			const int32 ChunkMinX = ChunkX << ChunkShift;
+			const int32 ChunkMinY = ChunkY << ChunkShift;
+			const int32 ChunkMaxX = FMath::Min(ChunkMinX + ChunkSize, Size.X);
+			const int32 ChunkMaxY = FMath::Min(ChunkMinY + ChunkSize, Size.Y);
+			const int32 MinCX = FMath::Max(X, ChunkMinX), MaxCX = FMath::Min(MaxX, ChunkMaxX);
+			const int32 MinCY = FMath::Max(Y, ChunkMinY), MaxCY = FMath::Min(MaxY, ChunkMaxY);
+
+			// Whole chunk covered: elide without touching cells
+			if (MinCX == ChunkMinX && MaxCX == ChunkMaxX && MinCY == ChunkMinY && MaxCY == ChunkMaxY)
+			{
+				ElideChunk(Chunk, CellType);
+				continue;
+			}
+
+			int32 Slot = ChunkSlots[Chunk];
+			if (Slot == INDEX_NONE)
+			{
+				if (UniformTypes[Chunk] == CellType) continue;
+				Slot = AllocateChunk(Chunk);
+			}
+
+			EGridCellType* Cells = SlotCells.GetData() + Slot * CellsPerChunk;
+			uint16* Counts = CountsOf(Slot);
+			for (int32 CY = MinCY; CY < MaxCY; ++CY)
+			{
+				const uint8 RowOffset = LocalYOffsets[CY & ChunkMask];
+				for (int32 CX = MinCX; CX < MaxCX; ++CX)
+				{
+					EGridCellType& Cell = Cells[RowOffset | LocalXOffsets[CX & ChunkMask]];
+					--Counts[static_cast<int32>(Cell)];
+					Cell = CellType;
+				}
+			}
+			Counts[static_cast<int32>(CellType)] += static_cast<uint16>((MaxCX - MinCX) * (MaxCY - MinCY));
+
+			TryElideChunk(Chunk);
+		}
+	}
+}
+
+int32 FGridChunkStore::ReplaceType(EGridCellType From, EGridCellType To)
+{
+	if (From == To) return 0;
+
+	int32 Replaced = 0;
+	for (int32 Chunk = 0; Chunk < ChunkSlots.Num(); ++Chunk)
+	{
+		const int32 Slot = ChunkSlots[Chunk];
+		if (Slot == INDEX_NONE)
+		{
+			if (UniformTypes[Chunk] == From) { UniformTypes[Chunk] = To; Replaced += InGridCellsOf(Chunk); }
+			continue;
+		}
+
+		uint16* Counts = CountsOf(Slot);
+		const int32 NumFrom = Counts[static_cast<int32>(From)];
+		if (NumFrom == 0) continue;
+
+		// Out-of-grid cells of edge chunks are rewritten too; they are never read or counted
+		EGridCellType* Cells = SlotCells.GetData() + Slot * CellsPerChunk;
+		for (int32 Local = 0; Local < CellsPerChunk; ++Local)
+		{
+			if (Cells[Local] == From) { Cells[Local] = To; }
+		}
+		Counts[static_cast<int32>(From)] = 0;
+		Counts[static_cast<int32>(To)] += static_cast<uint16>(NumFrom);
+		Replaced += NumFrom;
+
+		TryElideChunk(Chunk);
+	}
+	return Replaced;
+}
+#pragma endregion
+
+#pragma region Chunk Queries
+bool FGridChunkStore::GetChunkUniformType(int32 ChunkX, int32 ChunkY, EGridCellType& OutType) const
+{
+	const int32 Chunk = ChunkY * ChunksX + ChunkX;
+	if (ChunkSlots[Chunk] != INDEX_NONE) return false;
+	OutType = UniformTypes[Chunk]; return true;
+}
+
+void FGridChunkStore::GetChunkBounds(int32 ChunkX, int32 ChunkY, FIntPoint& OutStart, FIntPoint& OutSize) const
+{
+	OutStart = FIntPoint(ChunkX << ChunkShift, ChunkY << ChunkShift);
+	OutSize = FIntPoint(FMath::Min(ChunkSize, Size.X - OutStart.X), FMath::Min(ChunkSize, Size.Y - OutStart.Y));
+}
+
+int32 FGridChunkStore::CountInChunk(int32 ChunkX, int32 ChunkY, EGridCellType CellType) const
+{
+	const int32 Chunk = ChunkY * ChunksX + ChunkX;
+	const int32 Slot = ChunkSlots[Chunk];
+	if (Slot == INDEX_NONE) return UniformTypes[Chunk] == CellType ? InGridCellsOf(Chunk) : 0;
+	return CountsOf(Slot)[static_cast<int32>(CellType)];
+}
+#pragma endregion
+
+void FGridChunkStore::CopyTo(TArray<EGridCellType>& OutCells) const
+{
+	OutCells.SetNumUninitialized(Size.X * Size.Y);
+
+	for (int32 ChunkY = 0; ChunkY < ChunksY; ++ChunkY)
+	{
+		for (int32 ChunkX = 0; ChunkX < ChunksX; ++ChunkX)
+		{
+			const int32 Chunk = ChunkY * ChunksX + ChunkX;
+			const int32 Slot = ChunkSlots[Chunk];
+			FIntPoint Start, ChunkExtent;
+			GetChunkBounds(ChunkX, ChunkY, Start, ChunkExtent);
+
+			for (int32 LocalY = 0; LocalY < ChunkExtent.Y; ++LocalY)
+			{
+				EGridCellType* Dst = OutCells.GetData() + (Start.Y + LocalY) * Size.X + Start.X;
+				if (Slot == INDEX_NONE)
+				{
+					for (int32 LocalX = 0; LocalX < ChunkExtent.X; ++LocalX) { Dst[LocalX] = UniformTypes[Chunk]; }
+				}
+				else if (Layout == EGridMemoryLayout::RowMajor)
+				{
+					FMemory::Memcpy(Dst, SlotCells.GetData() + Slot * CellsPerChunk + (LocalY << ChunkShift), ChunkExtent.X * sizeof(EGridCellType));
+				}
+				else
+				{
+					const EGridCellType* Src = SlotCells.GetData() + Slot * CellsPerChunk;
+					const uint8 RowOffset = LocalYOffsets[LocalY];
+					for (int32 LocalX = 0; LocalX < ChunkExtent.X; ++LocalX) { Dst[LocalX] = Src[RowOffset | LocalXOffsets[LocalX]]; }
+				}
+			}
+		}
+	}
+}
+
+#pragma region Chunk Allocation
+int32 FGridChunkStore::InGridCellsOf(int32 Chunk) const
+{
+	FIntPoint Start, ChunkExtent;
+	GetChunkBounds(Chunk % ChunksX, Chunk / ChunksX, Start, ChunkExtent);
+	return ChunkExtent.X * ChunkExtent.Y;
+}
+
+int32 FGridChunkStore::AllocateChunk(int32 Chunk)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0) { Slot = FreeSlots.Pop(EAllowShrinking::No); }
+	else
+	{
+		Slot = SlotTypeCounts.Num() / NumCellTypes;
+		SlotCells.AddUninitialized(CellsPerChunk);
+		SlotTypeCounts.AddUninitialized(NumCellTypes);
+	}
+
+	const EGridCellType FillType = UniformTypes[Chunk];
+	EGridCellType* Cells = SlotCells.GetData() + Slot * CellsPerChunk;
+	for (int32 Local = 0; Local < CellsPerChunk; ++Local) { Cells[Local] = FillType; }
+
+	uint16* Counts = CountsOf(Slot);
+	FMemory::Memzero(Counts, NumCellTypes * sizeof(uint16));
+	Counts[static_cast<int32>(FillType)] = static_cast<uint16>(InGridCellsOf(Chunk));
+
+	ChunkSlots[Chunk] = Slot;
+	--NumElided;
+	return Slot;
+}
+
+void FGridChunkStore::ElideChunk(int32 Chunk, EGridCellType CellType)
+{
+	UniformTypes[Chunk] = CellType;
+	if (ChunkSlots[Chunk] == INDEX_NONE) return;
+
+	FreeSlots.Add(ChunkSlots[Chunk]);
+	ChunkSlots[Chunk] = INDEX_NONE;
+	++NumElided;
+
+	// Trim the pool once every allocated chunk has been released
+	if (NumElided == ChunkSlots.Num())
+	{
+		SlotCells.Empty();
+		SlotTypeCounts.Empty();
+		FreeSlots.Empty();
+	}
+}
+
+void FGridChunkStore::TryElideChunk(int32 Chunk)
+{
+	const int32 Slot = ChunkSlots[Chunk];
+	if (Slot == INDEX_NONE) return;
+
+	const uint16* Counts = CountsOf(Slot);
+	const int32 InGridCells = InGridCellsOf(Chunk);
+	for (int32 Type = 0; Type < NumCellTypes; ++Type)
+	{
+		if (Counts[Type] == InGridCells) { ElideChunk(Chunk, static_cast<EGridCellType>(Type)); return; }
+	}
+}
+#pragma endregion
@@ -0,0 +1,140 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridConnectivity.h"
+
+namespace GridConnectivityUnion
+{
+	/** Root of a run (path halving) */
+	FORCEINLINE int32 Find(TArray<int32>& Parent, int32 Run)
+	{
+		while (Parent[Run] != Run)
+		{
+			Parent[Run] = Parent[Parent[Run]];
+			Run = Parent[Run];
+		}
+		return Run;
+	}
+
+	/** Merge two sets, keeping the lower (earlier row-major) root */
+	FORCEINLINE void Union(TArray<int32>& Parent, int32 A, int32 B)
+	{
+		A = Find(Parent, A);
+		B = Find(Parent, B);
+		if (A < B) { Parent[B] = A; }
+		else if (B < A) { Parent[A] = B; }
+	}
+}
+
+void FGridConnectivity::Build(const FGridBitboard& Board, TConstArrayView<int32> WalkablePlanes)
+{
+	Reset();
+	Size = FIntPoint(Board.GetWidth(), Board.GetHeight());
+	Masks.Init(Size, 2);
+	NumWalkable = Masks.CopyPlaneUnion(WalkablePlane, Board, WalkablePlanes, false);
+
+	// Runs per row, each unioned with the overlapping runs of the previous row
+	TArray<int32> Parent;
+	RowFirstRun.SetNumUninitialized(Size.Y + 1);
+	for (int32 Y = 0; Y < Size.Y; ++Y)
+	{
+		RowFirstRun[Y] = Runs.Num();
+		int32 Below = Y > 0 ? RowFirstRun[Y - 1] : 0;
+		const int32 BelowEnd = RowFirstRun[Y];
+
+		for (int32 X0 = Masks.FindNextSet(WalkablePlane, Y, 0); X0 != INDEX_NONE; )
+		{
+			const int32 NextClear = Masks.FindNextClear(WalkablePlane, Y, X0);
+			const int32 X1 = NextClear == INDEX_NONE ? Size.X : NextClear;
+
+			const int32 Run = Runs.Add({ Y, X0, X1, INDEX_NONE });
+			Parent.Add(Run);
+
+			// Skip runs of the previous row ending before this one; every run still overlapping is merged
+			while (Below < BelowEnd && Runs[Below].X1 <= X0) { ++Below; }
+			for (int32 Other = Below; Other < BelowEnd && Runs[Other].X0 < X1; ++Other)
+			{
+				GridConnectivityUnion::Union(Parent, Run, Other);
+			}
+
+			X0 = X1 < Size.X ? Masks.FindNextSet(WalkablePlane, Y, X1) : INDEX_NONE;
+		}
+	}
+	RowFirstRun[Size.Y] = Runs.Num();
+
+	// Roots are the first run of their component, so one ordered pass numbers components row-major
+	for (int32 Run = 0; Run < Runs.Num(); ++Run)
+	{
+		const int32 Root = GridConnectivityUnion::Find(Parent, Run);
+		if (Root == Run)
+		{
+			Runs[Run].Component = ComponentSizes.Add(0);
+			ComponentAnchors.Add(FIntPoint(Runs[Run].X0, Runs[Run].Y));
+		}
+		else
+		{
+			Runs[Run].Component = Runs[Root].Component;
+		}
+		ComponentSizes[Runs[Run].Component] += Runs[Run].X1 - Runs[Run].X0;
+	}
+
+	ComponentReached.Init(false, ComponentSizes.Num());
+}
+
+void FGridConnectivity::Reset()
+{
+	Size = FIntPoint::ZeroValue;
+	Masks.Reset();
+	Runs.Reset();
+	RowFirstRun.Reset();
+	ComponentSizes.Reset();
+	ComponentAnchors.Reset();
+	ComponentReached.Reset();
+	NumWalkable = NumReachable = 0;
+}
+
+int32 FGridConnectivity::FloodFrom(TConstArrayView<FIntPoint> Seeds)
+{
+	if (!IsBuilt()) return 0;
+
+	for (bool& bReached : ComponentReached) { bReached = false; }
+	for (const FIntPoint& Seed : Seeds)
+	{
+		const int32 Component = GetComponent(Seed);
+		if (Component != INDEX_NONE) { ComponentReached[Component] = true; }
+	}
+
+	// Reachable bitset: whole runs of reached components
+	Masks.FillPlane(ReachablePlane, false);
+	NumReachable = 0;
+	for (const FRun& Run : Runs)
+	{
+		if (!ComponentReached[Run.Component]) continue;
+		Masks.SetRect(ReachablePlane, Run.X0, Run.Y, Run.X1 - Run.X0, 1, true);
+		NumReachable += Run.X1 - Run.X0;
+	}
+	return NumReachable;
+}
+
+#pragma region Queries
+int32 FGridConnectivity::FindRun(FIntPoint Cell) const
+{
+	if (!IsWalkable(Cell)) return INDEX_NONE;
+
+	// Last run of the row starting at or before X (the cell is walkable, so that run holds it)
+	int32 Lo = RowFirstRun[Cell.Y];
+	int32 Hi = RowFirstRun[Cell.Y + 1];
+	while (Hi - Lo > 1)
+	{
+		const int32 Mid = (Lo + Hi) >> 1;
+		if (Runs[Mid].X0 <= Cell.X) { Lo = Mid; }
+		else { Hi = Mid; }
+	}
+	return Lo;
+}
+
+int32 FGridConnectivity::GetComponent(FIntPoint Cell) const
+{
+	const int32 Run = FindRun(Cell);
+	return Run != INDEX_NONE ? Runs[Run].Component : INDEX_NONE;
+}
+#pragma endregion
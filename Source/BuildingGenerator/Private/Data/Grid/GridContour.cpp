@@ -0,0 +1,205 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridContour.h"
+
+FIntPoint FGridContourRun::GetStartVertex() const
+{
+	switch (Side)
+	{
+	case ECellDirection::South:	return FIntPoint(First, Lane);					// Walks +X
+	case ECellDirection::East:	return FIntPoint(Lane + 1, First);				// Walks +Y
+	case ECellDirection::North:	return FIntPoint(First + Length, Lane + 1);	// Walks -X
+	default:					return FIntPoint(Lane, First + Length);			// Walks -Y
+	}
+}
+
+FIntPoint FGridContourRun::GetEndVertex() const
+{
+	switch (Side)
+	{
+	case ECellDirection::South:	return FIntPoint(First + Length, Lane);
+	case ECellDirection::East:	return FIntPoint(Lane + 1, First + Length);
+	case ECellDirection::North:	return FIntPoint(First, Lane + 1);
+	default:					return FIntPoint(Lane, First);
+	}
+}
+
+namespace GridContourTrace
+{
+	/** Row Y of Plane into Dst[1..WordsPerRow], zero outside the grid; Dst[0] / Dst[WordsPerRow + 1] stay zero */
+	static void LoadRow(const FGridBitboard& Mask, int32 Plane, int32 Y, uint64* Dst)
+	{
+		const int32 WordsPerRow = Mask.GetWordsPerRow();
+		if (Y < 0 || Y >= Mask.GetHeight()) { FMemory::Memzero(Dst + 1, sizeof(uint64) * WordsPerRow); return; }
+		FMemory::Memcpy(Dst + 1, Mask.GetRow(Plane, Y), sizeof(uint64) * WordsPerRow);
+	}
+
+	FORCEINLINE uint64 East(const uint64* Row, int32 W) { return (Row[W] >> 1) | (Row[W + 1] << 63); }
+	FORCEINLINE uint64 West(const uint64* Row, int32 W) { return (Row[W] << 1) | (Row[W - 1] >> 63); }
+
+	/** Calls Func(X0, X1) for every run [X0, X1) of set bits (transition bits, so whole words of zeros or ones cost one op) */
+	template<typename FuncType>
+	static void ForEachBitRun(const uint64* Words, int32 NumWords, FuncType&& Func)
+	{
+		int32 RunStart = INDEX_NONE;
+		uint64 Carry = 0;
+		for (int32 W = 0; W < NumWords; ++W)
+		{
+			const uint64 Word = Words[W];
+			for (uint64 Flips = Word ^ ((Word << 1) | Carry); Flips != 0; Flips &= Flips - 1)
+			{
+				const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Flips));
+				if ((Word >> Bit) & 1ull) { RunStart = (W << 6) + Bit; }
+				else { Func(RunStart, (W << 6) + Bit); RunStart = INDEX_NONE; }
+			}
+			Carry = Word >> 63;
+		}
+		if (RunStart != INDEX_NONE) { Func(RunStart, NumWords << 6); }
+	}
+
+	/** Side whose walk direction is a left turn from Side's (South +X -> East +Y -> North -X -> West -Y) */
+	FORCEINLINE ECellDirection LeftTurn(ECellDirection Side) { return static_cast<ECellDirection>((static_cast<uint8>(Side) + 3) & 3); }
+}
+
+void FGridContour::Trace(const FGridBitboard& Mask, int32 Plane)
+{
+	Reset();
+	const int32 Width = Mask.GetWidth();
+	const int32 Height = Mask.GetHeight();
+	const int32 WordsPerRow = Mask.GetWordsPerRow();
+	if (Width <= 0 || Height <= 0) return;
+
+	// Rolling padded rows (below, current, above) and per-row side words
+	const int32 Padded = WordsPerRow + 2;
+	TArray<uint64> Scratch;
+	Scratch.SetNumZeroed(3 * Padded + 6 * WordsPerRow);
+	uint64* Below = Scratch.GetData();
+	uint64* Current = Below + Padded;
+	uint64* Above = Current + Padded;
+	uint64* SouthBits = Above + Padded;
+	uint64* NorthBits = SouthBits + WordsPerRow;
+	uint64* EastBits = NorthBits + WordsPerRow;
+	uint64* WestBits = EastBits + WordsPerRow;
+	uint64* PrevEast = WestBits + WordsPerRow;
+	uint64* PrevWest = PrevEast + WordsPerRow;
+
+	// Row where the open East / West run of each column started
+	TArray<int32> EastStart, WestStart;
+	EastStart.SetNumUninitialized(Width);
+	WestStart.SetNumUninitialized(Width);
+
+	TArray<FGridContourRun> Unordered;
+	auto CloseColumns = [&Unordered](uint64 Ends, int32 Base, ECellDirection Side, const TArray<int32>& Starts, int32 Y)
+	{
+		for (; Ends != 0; Ends &= Ends - 1)
+		{
+			const int32 X = Base + static_cast<int32>(FMath::CountTrailingZeros64(Ends));
+			Unordered.Add({ Side, Starts[X], Y - Starts[X], X });
+		}
+	};
+
+	GridContourTrace::LoadRow(Mask, Plane, -1, Below);
+	GridContourTrace::LoadRow(Mask, Plane, 0, Current);
+
+	// One extra (empty) row closes every East/West run still open at the top
+	for (int32 Y = 0; Y <= Height; ++Y)
+	{
+		GridContourTrace::LoadRow(Mask, Plane, Y + 1, Above);
+
+		for (int32 W = 0; W < WordsPerRow; ++W)
+		{
+			const int32 P = W + 1;
+			const uint64 In = Current[P];
+			SouthBits[W] = In & ~Below[P];
+			NorthBits[W] = In & ~Above[P];
+			EastBits[W] = In & ~GridContourTrace::East(Current, P);
+			WestBits[W] = In & ~GridContourTrace::West(Current, P);
+
+			// Columns whose side run starts on this row / ended on the previous one
+			const int32 Base = W << 6;
+			for (uint64 Starts = EastBits[W] & ~PrevEast[W]; Starts != 0; Starts &= Starts - 1) { EastStart[Base + FMath::CountTrailingZeros64(Starts)] = Y; }
+			for (uint64 Starts = WestBits[W] & ~PrevWest[W]; Starts != 0; Starts &= Starts - 1) { WestStart[Base + FMath::CountTrailingZeros64(Starts)] = Y; }
+			CloseColumns(PrevEast[W] & ~EastBits[W], Base, ECellDirection::East, EastStart, Y);
+			CloseColumns(PrevWest[W] & ~WestBits[W], Base, ECellDirection::West, WestStart, Y);
+		}
+
+		GridContourTrace::ForEachBitRun(SouthBits, WordsPerRow, [&](int32 X0, int32 X1) { Unordered.Add({ ECellDirection::South, X0, X1 - X0, Y }); });
+		GridContourTrace::ForEachBitRun(NorthBits, WordsPerRow, [&](int32 X0, int32 X1) { Unordered.Add({ ECellDirection::North, X0, X1 - X0, Y }); });
+
+		Swap(PrevEast, EastBits);
+		Swap(PrevWest, WestBits);
+		uint64* Recycled = Below;
+		Below = Current;
+		Current = Above;
+		Above = Recycled;
+	}
+
+	// Chain runs into loops: each run continues with the run starting at its end vertex
+	const int32 NumRuns = Unordered.Num();
+	TMap<FIntPoint, int32> StartAt;
+	StartAt.Reserve(NumRuns);
+	TArray<int32> SaddlePartner;
+	SaddlePartner.Init(INDEX_NONE, NumRuns);
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		const FIntPoint Vertex = Unordered[Run].GetStartVertex();
+		if (const int32* Existing = StartAt.Find(Vertex)) { SaddlePartner[*Existing] = Run; }
+		else { StartAt.Add(Vertex, Run); }
+	}
+
+	TArray<bool> Visited;
+	Visited.Init(false, NumRuns);
+	Runs.Reserve(NumRuns);
+	Corners.Reserve(NumRuns);
+	for (int32 First = 0; First < NumRuns; ++First)
+	{
+		if (Visited[First]) continue;
+
+		LoopStarts.Add(Runs.Num());
+		int64 DoubleArea = 0;
+		int32 Run = First;
+		do
+		{
+			Visited[Run] = true;
+			const FGridContourRun& Edge = Unordered[Run];
+			Runs.Add(Edge);
+
+			const FIntPoint From = Edge.GetStartVertex();
+			const FIntPoint To = Edge.GetEndVertex();
+			DoubleArea += static_cast<int64>(From.X) * To.Y - static_cast<int64>(To.X) * From.Y;
+
+			// Two cells touching diagonally: two runs start here, keep turning left around the current cell
+			int32 Next = StartAt.FindChecked(To);
+			if (SaddlePartner[Next] != INDEX_NONE && Unordered[Next].Side != GridContourTrace::LeftTurn(Edge.Side))
+			{
+				Next = SaddlePartner[Next];
+			}
+
+			FGridContourCorner& Corner = Corners.AddDefaulted_GetRef();
+			Corner.Vertex = To;
+			Corner.InSide = Edge.Side;
+			Corner.OutSide = Unordered[Next].Side;
+			Corner.bConvex = Corner.OutSide == GridContourTrace::LeftTurn(Edge.Side);
+			Run = Next;
+		}
+		while (Run != First);
+
+		LoopIsOuter.Add(DoubleArea > 0);
+	}
+	LoopStarts.Add(Runs.Num());
+}
+
+void FGridContour::Reset()
+{
+	Runs.Reset();
+	Corners.Reset();
+	LoopStarts.Reset();
+	LoopIsOuter.Reset();
+}
+
+int32 FGridContour::GetPerimeter() const
+{
+	int32 Perimeter = 0;
+	for (const FGridContourRun& Run : Runs) { Perimeter += Run.Length; }
+	return Perimeter;
+}
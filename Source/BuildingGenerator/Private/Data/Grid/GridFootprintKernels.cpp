@@ -0,0 +1,11 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridFootprintKernels.h"
+
+const FGridFootprintKernel FGridFootprintKernel::Table[MaxExtent][MaxExtent] =
+{
+	{ Make<1, 1>(), Make<2, 1>(), Make<3, 1>(), Make<4, 1>() },
+	{ Make<1, 2>(), Make<2, 2>(), Make<3, 2>(), Make<4, 2>() },
+	{ Make<1, 3>(), Make<2, 3>(), Make<3, 3>(), Make<4, 3>() },
+	{ Make<1, 4>(), Make<2, 4>(), Make<3, 4>(), Make<4, 4>() },
+};
@@ -0,0 +1,235 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridRunLengthCodec.h"
+
+namespace GridRunLength
+{
+	static constexpr int32 NumCellTypes = static_cast<int32>(EGridCellType::ECT_Void) + 1;
+	static constexpr int32 NumZones = static_cast<int32>(ECellZone::DeadEnd) + 1;
+	static_assert(NumCellTypes <= CopyAboveType && NumZones <= 8, "Cell type and zone are packed in 3 bits each, type 7 reserved");
+
+	FORCEINLINE uint8 MakeSymbol(EGridCellType CellType, ECellZone Zone)
+	{
+		return static_cast<uint8>(CellType) | (static_cast<uint8>(Zone) << 3);
+	}
+}
+
+#pragma region Encoder
+FGridRunLengthEncoder::FGridRunLengthEncoder(TArray<uint8>& OutBytes, FIntPoint InGridSize, bool bInHasZones)
+	: Bytes(OutBytes)
+	, Width(FMath::Max(InGridSize.X, 0))
+	, TotalCells(static_cast<int64>(FMath::Max(InGridSize.X, 0)) * FMath::Max(InGridSize.Y, 0))
+	, bHasZones(bInHasZones)
+{
+	Bytes.Add(GridRunLength::FormatVersion);
+	Bytes.Add(bHasZones ? GridRunLength::FlagHasZones : 0);
+	WriteVarint(static_cast<uint32>(Width));
+	WriteVarint(static_cast<uint32>(FMath::Max(InGridSize.Y, 0)));
+
+	PrevRow.SetNumZeroed(Width);
+	CurRow.SetNumZeroed(Width);
+}
+
+void FGridRunLengthEncoder::Push(EGridCellType CellType, ECellZone Zone, int32 Count)
+{
+	const uint8 Symbol = GridRunLength::MakeSymbol(CellType, bHasZones ? Zone : ECellZone::Empty);
+	for (; Count > 0; --Count)
+	{
+		// Cells past the grid only count toward the mismatch Finish reports
+		if (PushedCells++ >= TotalCells) continue;
+
+		// Extend the open run if it still matches, else start a copy run where the row above agrees, a literal run otherwise
+		const bool bMatchesAbove = bHasPrevRow && PrevRow[X] == Symbol;
+		const bool bExtends = RunLength > 0 && (bRunIsCopy ? bMatchesAbove : RunSymbol == Symbol);
+		if (!bExtends)
+		{
+			FlushRun();
+			bRunIsCopy = bMatchesAbove;
+			RunSymbol = Symbol;
+		}
+		RunLength++;
+
+		CurRow[X] = Symbol;
+		if (++X == Width)
+		{
+			Swap(PrevRow, CurRow);
+			X = 0;
+			bHasPrevRow = true;
+		}
+	}
+}
+
+bool FGridRunLengthEncoder::Finish()
+{
+	FlushRun();
+	return PushedCells == TotalCells;
+}
+
+void FGridRunLengthEncoder::FlushRun()
+{
+	if (RunLength <= 0) return;
+	const uint8 Symbol = bRunIsCopy ? GridRunLength::CopyAboveType : RunSymbol;
+
+	// Short runs ride in the symbol's top bits, longer ones append a varint
+	if (RunLength < GridRunLength::MinVarintRun)
+	{
+		Bytes.Add(Symbol | static_cast<uint8>(RunLength << 6));
+	}
+	else
+	{
+		Bytes.Add(Symbol);
+		WriteVarint(static_cast<uint32>(RunLength - GridRunLength::MinVarintRun));
+	}
+	RunLength = 0;
+}
+
+void FGridRunLengthEncoder::WriteVarint(uint32 Value)
+{
+	while (Value >= 0x80)
+	{
+		Bytes.Add(static_cast<uint8>(Value | 0x80));
+		Value >>= 7;
+	}
+	Bytes.Add(static_cast<uint8>(Value));
+}
+#pragma endregion
+
+#pragma region Decoder
+bool FGridRunLengthDecoder::ReadHeader()
+{
+	Offset = 0;
+	bError = true;
+	if (Bytes.Num() < 2 || Bytes[0] != GridRunLength::FormatVersion) return false;
+	bHasZones = (Bytes[1] & GridRunLength::FlagHasZones) != 0;
+	Offset = 2;
+
+	uint32 Width = 0, Height = 0;
+	if (!ReadVarint(Width) || !ReadVarint(Height)) return false;
+
+	// Untrusted sizes: bound them before sizing the row buffers (and DecodeAll's output)
+	if (Width > GridRunLength::MaxDimension || Height > GridRunLength::MaxDimension
+		|| static_cast<int64>(Width) * Height > GridRunLength::MaxCells) return false;
+
+	GridSize = FIntPoint(static_cast<int32>(Width), static_cast<int32>(Height));
+	RemainingCells = static_cast<int64>(Width) * Height;
+	PendingCopy = 0;
+	PrevRow.SetNumZeroed(GridSize.X);
+	CurRow.SetNumZeroed(GridSize.X);
+	X = 0;
+	bHasPrevRow = false;
+	bHeaderRead = true;
+	bError = false;
+	return true;
+}
+
+bool FGridRunLengthDecoder::NextRun(EGridCellType& OutCellType, ECellZone& OutZone, int32& OutCount)
+{
+	if (bError || !bHeaderRead) return false;
+
+	uint8 Symbol = 0;
+	int32 Count = 0;
+	if (PendingCopy == 0)
+	{
+		if (RemainingCells == 0) return false;
+		if (Offset >= Bytes.Num()) { bError = true; return false; }
+
+		const uint8 Header = Bytes[Offset++];
+		int64 RunLength = Header >> 6;
+		if (RunLength == 0)
+		{
+			uint32 Extra = 0;
+			if (!ReadVarint(Extra)) { bError = true; return false; }
+			RunLength = static_cast<int64>(Extra) + GridRunLength::MinVarintRun;
+		}
+		Symbol = Header & 0x3F;
+
+		// Reject symbols outside the enums, copies with no row above and runs past the end of the grid
+		const uint8 CellType = Symbol & 0x7;
+		const uint8 Zone = Symbol >> 3;
+		const bool bCopy = CellType == GridRunLength::CopyAboveType;
+		if ((bCopy && (Zone != 0 || !bHasPrevRow)) || Zone >= GridRunLength::NumZones || (!bHasZones && Zone != 0) || RunLength > RemainingCells)
+		{
+			bError = true;
+			return false;
+		}
+		RemainingCells -= RunLength;
+
+		if (!bCopy)
+		{
+			Count = static_cast<int32>(RunLength);
+			Emit(Symbol, Count);
+		}
+		else { PendingCopy = static_cast<int32>(RunLength); }
+	}
+
+	// Copy runs come out one stretch of equal cells of the row above at a time
+	if (PendingCopy > 0)
+	{
+		Symbol = PrevRow[X];
+		Count = 1;
+		while (Count < PendingCopy && X + Count < GridSize.X && PrevRow[X + Count] == Symbol) { ++Count; }
+		PendingCopy -= Count;
+		Emit(Symbol, Count);
+	}
+
+	OutCellType = static_cast<EGridCellType>(Symbol & 0x7);
+	OutZone = static_cast<ECellZone>(Symbol >> 3);
+	OutCount = Count;
+	return true;
+}
+
+void FGridRunLengthDecoder::Emit(uint8 Symbol, int32 Count)
+{
+	while (Count > 0)
+	{
+		const int32 Span = FMath::Min(Count, GridSize.X - X);
+		FMemory::Memset(CurRow.GetData() + X, Symbol, Span);
+		X += Span;
+		Count -= Span;
+		if (X == GridSize.X)
+		{
+			Swap(PrevRow, CurRow);
+			X = 0;
+			bHasPrevRow = true;
+		}
+	}
+}
+
+bool FGridRunLengthDecoder::DecodeAll(TConstArrayView<uint8> InBytes, FIntPoint& OutGridSize, TArray<EGridCellType>& OutCells, TArray<ECellZone>& OutZones)
+{
+	FGridRunLengthDecoder Decoder(InBytes);
+	if (!Decoder.ReadHeader()) return false;
+
+	OutGridSize = Decoder.GetGridSize();
+	OutCells.Reset(OutGridSize.X * OutGridSize.Y);
+	OutZones.Reset(Decoder.HasZones() ? OutGridSize.X * OutGridSize.Y : 0);
+
+	EGridCellType CellType;
+	ECellZone Zone;
+	int32 Count;
+	while (Decoder.NextRun(CellType, Zone, Count))
+	{
+		const int32 FirstCell = OutCells.AddUninitialized(Count);
+		FMemory::Memset(OutCells.GetData() + FirstCell, static_cast<uint8>(CellType), Count);
+		if (Decoder.HasZones())
+		{
+			const int32 FirstZone = OutZones.AddUninitialized(Count);
+			FMemory::Memset(OutZones.GetData() + FirstZone, static_cast<uint8>(Zone), Count);
+		}
+	}
+	return Decoder.IsComplete();
+}
+
+bool FGridRunLengthDecoder::ReadVarint(uint32& OutValue)
+{
+	OutValue = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		if (Offset >= Bytes.Num()) return false;
+		const uint8 Byte = Bytes[Offset++];
+		OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0) return true;
+	}
+	return false;
+}
+#pragma endregion
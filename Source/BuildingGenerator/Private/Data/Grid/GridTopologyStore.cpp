@@ -0,0 +1,481 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridTopologyStore.h"
+#include "Data/Grid/GridBitboard.h"
+#include "Data/Grid/GridRowBands.h"
+#include "Data/Grid/GridZoneTable.h"
+#include "Containers/StaticArray.h"
+
+void GridDirectionMask::ToDirectionSet(uint8 Mask, TSet<ECellDirection>& OutDirections)
+{
+	for (uint8 Dir = 0; Dir < 4; ++Dir)
+	{
+		if (Mask & (1 << Dir)) { OutDirections.Add(static_cast<ECellDirection>(Dir)); }
+	}
+}
+
+void FGridTopologyStore::Init(FIntPoint InSize)
+{
+	Size = FIntPoint(FMath::Max(InSize.X, 0), FMath::Max(InSize.Y, 0));
+	const int32 NumCells = Size.X * Size.Y;
+
+	Zones.Reset();
+	Zones.Init(ECellZone::Empty, NumCells);
+	WallMasks.Reset();
+	WallMasks.SetNumZeroed(NumCells);
+	OpenMasks.Reset();
+	OpenMasks.SetNumZeroed(NumCells);
+	WallDistances.Reset();
+	WallDistances.SetNumZeroed(NumCells);
+	WallDistanceBound = 0;
+
+	// Nothing analyzed yet, so the empty index is current
+	ZoneCells.Reset();
+	BorderCells.Reset();
+	FMemory::Memzero(ZoneStarts, sizeof(ZoneStarts));
+	ZoneSlots.Reset();
+	ZoneSlots.Init(INDEX_NONE, NumCells);
+	BorderSlots.Reset();
+	BorderSlots.Init(INDEX_NONE, NumCells);
+	bZoneIndexStale = false;
+}
+
+void FGridTopologyStore::Reset()
+{
+	Size = FIntPoint::ZeroValue;
+	Zones.Empty();
+	WallMasks.Empty();
+	OpenMasks.Empty();
+	WallDistances.Empty();
+	WallDistanceBound = 0;
+	ZoneCells.Empty();
+	BorderCells.Empty();
+	FMemory::Memzero(ZoneStarts, sizeof(ZoneStarts));
+	ZoneSlots.Empty();
+	BorderSlots.Empty();
+	bZoneIndexStale = false;
+}
+
+FCellData FGridTopologyStore::MakeCellData(FIntPoint Cell) const
+{
+	if (!IsValidCell(Cell) || !IsInitialized()) return FCellData();
+
+	const int32 Index = IndexOf(Cell);
+	if (!IsAnalyzed(Index))
+	{
+		FCellData Unoccupied;
+		Unoccupied.Coordinates = Cell;
+		return Unoccupied;
+	}
+
+	FCellData CellData(Cell);
+	CellData.CellZone = Zones[Index];
+	CellData.DistanceToWall = WallDistances[Index];
+	GridDirectionMask::ToDirectionSet(WallMasks[Index], CellData.WallDirections);
+	GridDirectionMask::ToDirectionSet(OpenMasks[Index], CellData.OpenDirections);
+	return CellData;
+}
+
+#pragma region Analysis
+namespace GridTopologyRows
+{
+	/** Open (GridWalkable) bits of row Y into Dst[1..WordsPerRow]; Dst[0] / Dst[WordsPerRow + 1] stay zero so shifts need no edge checks */
+	static void LoadOpenRow(const FGridBitboard& Board, int32 Y, uint64* Dst)
+	{
+		const int32 WordsPerRow = Board.GetWordsPerRow();
+		if (Y < 0 || Y >= Board.GetHeight())
+		{
+			FMemory::Memzero(Dst + 1, sizeof(uint64) * WordsPerRow);
+			return;
+		}
+
+		for (int32 W = 0; W < WordsPerRow; ++W) { Dst[W + 1] = GridWalkable::GetRowWord(Board, Y, W); }
+	}
+
+	/** Neighbour to the east (X + 1) / west (X - 1) of every bit of padded word W */
+	FORCEINLINE uint64 East(const uint64* Row, int32 W) { return (Row[W] >> 1) | (Row[W + 1] << 63); }
+	FORCEINLINE uint64 West(const uint64* Row, int32 W) { return (Row[W] << 1) | (Row[W - 1] >> 63); }
+}
+
+int32 FGridTopologyStore::AnalyzeRows(const FGridBitboard& Board, int32 FirstRow, int32 NumRows)
+{
+	check(Board.GetWidth() == Size.X && Board.GetHeight() == Size.Y);
+	const int32 EndRow = FMath::Min(FirstRow + NumRows, Size.Y);
+	FirstRow = FMath::Max(FirstRow, 0);
+	if (FirstRow >= EndRow) return 0;
+
+	bZoneIndexStale = true;
+	return AnalyzeBand(Board, FirstRow, EndRow);
+}
+
+int32 FGridTopologyStore::AnalyzeAllRows(const FGridBitboard& Board, int32 NumBands)
+{
+	check(Board.GetWidth() == Size.X && Board.GetHeight() == Size.Y);
+	bZoneIndexStale = true;
+
+	TArray<int32, TInlineAllocator<16>> BandAnalyzed;
+	BandAnalyzed.SetNumZeroed(FMath::Max(NumBands, 1));
+	GridRowBands::ForEachBand(Size.Y, NumBands, [this, &Board, &BandAnalyzed](int32 Band, int32 FirstRow, int32 EndRow)
+	{
+		BandAnalyzed[Band] = AnalyzeBand(Board, FirstRow, EndRow);
+	});
+
+	int32 NumAnalyzed = 0;
+	for (const int32 Count : BandAnalyzed) { NumAnalyzed += Count; }
+	return NumAnalyzed;
+}
+
+int32 FGridTopologyStore::AnalyzeBand(const FGridBitboard& Board, int32 FirstRow, int32 EndRow)
+{
+	// Rolling window of padded open rows (south, current, north)
+	const int32 WordsPerRow = Board.GetWordsPerRow();
+	const int32 Padded = WordsPerRow + 2;
+	TArray<uint64, TInlineAllocator<3 * 8>> Window;
+	Window.SetNumZeroed(3 * Padded);
+	uint64* South = Window.GetData();
+	uint64* Current = South + Padded;
+	uint64* North = Current + Padded;
+	GridTopologyRows::LoadOpenRow(Board, FirstRow - 1, South);
+	GridTopologyRows::LoadOpenRow(Board, FirstRow, Current);
+
+	const int32 FloorPlane = FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh);
+	const int32 CustomPlane = FGridBitboard::PlaneOf(EGridCellType::ECT_Custom);
+	int32 NumAnalyzed = 0;
+
+	for (int32 Y = FirstRow; Y < EndRow; ++Y)
+	{
+		GridTopologyRows::LoadOpenRow(Board, Y + 1, North);
+
+		const int32 RowBase = Y * Size.X;
+		FMemory::Memset(Zones.GetData() + RowBase, static_cast<uint8>(ECellZone::Empty), Size.X);
+		FMemory::Memzero(WallMasks.GetData() + RowBase, Size.X);
+
+		const uint64* FloorRow = Board.GetRow(FloorPlane, Y);
+		const uint64* CustomRow = Board.GetRow(CustomPlane, Y);
+
+		for (int32 W = 0; W < WordsPerRow; ++W)
+		{
+			const uint64 Occupied = FloorRow[W] | CustomRow[W];
+			if (Occupied == 0) continue;
+
+			// Neighbour presence for all 64 cells of the word, in GridNeighborMask bit order
+			const int32 P = W + 1;
+			const uint64 Neighbors[8] = {
+				North[P],
+				GridTopologyRows::East(Current, P),
+				South[P],
+				GridTopologyRows::West(Current, P),
+				GridTopologyRows::East(North, P),
+				GridTopologyRows::East(South, P),
+				GridTopologyRows::West(South, P),
+				GridTopologyRows::West(North, P)
+			};
+
+			uint64 Surrounded = Occupied;
+			for (const uint64 Word : Neighbors) { Surrounded &= Word; }
+
+			ECellZone* ZoneWord = Zones.GetData() + RowBase + (W << 6);
+			uint8* WallWord = WallMasks.GetData() + RowBase + (W << 6);
+			NumAnalyzed += FMath::CountBits(Occupied);
+
+			// Interior word: every cell is Center with no walls (already zeroed)
+			if (Surrounded == ~0ull)
+			{
+				FMemory::Memset(ZoneWord, static_cast<uint8>(ECellZone::Center), 64);
+				continue;
+			}
+
+			for (uint64 Bits = Surrounded; Bits != 0; Bits &= Bits - 1)
+			{
+				ZoneWord[FMath::CountTrailingZeros64(Bits)] = ECellZone::Center;
+			}
+
+			for (uint64 Bits = Occupied & ~Surrounded; Bits != 0; Bits &= Bits - 1)
+			{
+				const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+				uint8 NeighborMask = 0;
+				for (int32 Dir = 0; Dir < 8; ++Dir) { NeighborMask |= static_cast<uint8>((Neighbors[Dir] >> Bit) & 1) << Dir; }
+
+				ZoneWord[Bit] = GridZoneTable::Lookup(NeighborMask);
+				WallWord[Bit] = GridNeighborMask::WallsOf(NeighborMask);
+			}
+		}
+
+		// Slide the window north
+		uint64* Recycled = South;
+		South = Current;
+		Current = North;
+		North = Recycled;
+	}
+
+	return NumAnalyzed;
+}
+
+int32 FGridTopologyStore::UpdateCells(const FGridBitboard& Board, const FIntRect& DirtyRect)
+{
+	check(Board.GetWidth() == Size.X && Board.GetHeight() == Size.Y);
+
+	// Dirty cells plus their 8-neighbour ring, clipped to the grid
+	const int32 MinX = FMath::Max(DirtyRect.Min.X - 1, 0);
+	const int32 MinY = FMath::Max(DirtyRect.Min.Y - 1, 0);
+	const int32 MaxX = FMath::Min(DirtyRect.Max.X + 1, Size.X);
+	const int32 MaxY = FMath::Min(DirtyRect.Max.Y + 1, Size.Y);
+	if (MinX >= MaxX || MinY >= MaxY) return 0;
+
+	const int32 FloorPlane = FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh);
+	const int32 CustomPlane = FGridBitboard::PlaneOf(EGridCellType::ECT_Custom);
+	auto IsOpen = [&](int32 X, int32 Y)
+	{
+		return X >= 0 && Y >= 0 && X < Size.X && Y < Size.Y && GridWalkable::IsSet(Board, X, Y);
+	};
+
+	const bool bPatchIndex = !bZoneIndexStale;
+	int32 NumChanged = 0;
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		for (int32 X = MinX; X < MaxX; ++X)
+		{
+			ECellZone NewZone = ECellZone::Empty;
+			uint8 NewWalls = 0;
+			if (Board.GetBit(FloorPlane, X, Y) || Board.GetBit(CustomPlane, X, Y))
+			{
+				uint8 NeighborMask = 0;
+				for (int32 Dir = 0; Dir < 8; ++Dir)
+				{
+					NeighborMask |= static_cast<uint8>(IsOpen(X + GridNeighborMask::OffsetX[Dir], Y + GridNeighborMask::OffsetY[Dir])) << Dir;
+				}
+				NewZone = GridZoneTable::Lookup(NeighborMask);
+				NewWalls = GridNeighborMask::WallsOf(NeighborMask);
+			}
+
+			const int32 Index = Y * Size.X + X;
+			const ECellZone OldZone = Zones[Index];
+			const uint8 OldWalls = WallMasks[Index];
+			if (NewZone == OldZone && NewWalls == OldWalls) continue;
+			++NumChanged;
+
+			if (bPatchIndex)
+			{
+				if (NewZone != OldZone)
+				{
+					if (OldZone != ECellZone::Empty) { RemoveFromZoneIndex(Index, OldZone); }
+					if (NewZone != ECellZone::Empty) { AddToZoneIndex(Index, NewZone); }
+				}
+				if ((OldWalls != 0) != (NewWalls != 0))
+				{
+					if (OldWalls != 0) { RemoveFromBorderCells(Index); }
+					else { AddToBorderCells(Index); }
+				}
+			}
+
+			Zones[Index] = NewZone;
+			WallMasks[Index] = NewWalls;
+		}
+	}
+
+	return NumChanged;
+}
+#pragma endregion
+
+#pragma region Wall Distance
+void FGridTopologyStore::BuildWallDistances(const FGridBitboard& Board)
+{
+	check(Board.GetWidth() == Size.X && Board.GetHeight() == Size.Y);
+	WallDistanceBound = BuildWallDistancesInRect(Board, FIntRect(FIntPoint::ZeroValue, Size));
+}
+
+int32 FGridTopologyStore::UpdateWallDistances(const FGridBitboard& Board, const FIntRect& DirtyRect)
+{
+	check(Board.GetWidth() == Size.X && Board.GetHeight() == Size.Y);
+
+	// A cell whose distance changes had its old or new nearest source in DirtyRect, at most the old maximum away
+	FIntRect Window = DirtyRect;
+	Window.InflateRect(WallDistanceBound);
+	Window.Clip(FIntRect(FIntPoint::ZeroValue, Size));
+	if (Window.Area() <= 0) return 0;
+
+	// The bound only grows here (cells outside the window keep their values); BuildWallDistances makes it exact again
+	WallDistanceBound = FMath::Max(WallDistanceBound, BuildWallDistancesInRect(Board, Window));
+	return Window.Area();
+}
+
+uint8 FGridTopologyStore::BuildWallDistancesInRect(const FGridBitboard& Board, const FIntRect& Window)
+{
+	auto Step = [](uint8 Distance) { return static_cast<uint8>(FMath::Min<int32>(Distance + 1, MaxWallDistance)); };
+
+	// Neighbours outside the window keep their (unaffected) values; outside the grid counts as a source
+	uint8* Distances = WallDistances.GetData();
+	const int32 MinX = Window.Min.X, MinY = Window.Min.Y, MaxX = Window.Max.X, MaxY = Window.Max.Y;
+
+	// Forward pass: sources (every non-walkable cell, as the wall masks of AnalyzeRows), then min over the -X / -Y neighbours
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		uint8* Row = Distances + Y * Size.X;
+		const uint8* Prev = Y > 0 ? Row - Size.X : nullptr;
+		uint64 Walkable = 0;
+
+		for (int32 X = MinX; X < MaxX; ++X)
+		{
+			if (X == MinX || (X & 63) == 0) { Walkable = GridWalkable::GetRowWord(Board, Y, X >> 6); }
+			if (!((Walkable >> (X & 63)) & 1ull)) { Row[X] = 0; continue; }
+
+			const uint8 FromBelow = Prev ? Prev[X] : 0;
+			const uint8 FromLeft = X > 0 ? Row[X - 1] : 0;
+			Row[X] = Step(FMath::Min(FromBelow, FromLeft));
+		}
+	}
+
+	// Backward pass: min over the +X / +Y neighbours
+	uint8 MaxDistance = 0;
+	for (int32 Y = MaxY - 1; Y >= MinY; --Y)
+	{
+		uint8* Row = Distances + Y * Size.X;
+		const uint8* Next = Y + 1 < Size.Y ? Row + Size.X : nullptr;
+
+		for (int32 X = MaxX - 1; X >= MinX; --X)
+		{
+			if (Row[X] == 0) continue;
+
+			const uint8 FromAbove = Next ? Next[X] : 0;
+			const uint8 FromRight = X + 1 < Size.X ? Row[X + 1] : 0;
+			Row[X] = FMath::Min(Row[X], Step(FMath::Min(FromAbove, FromRight)));
+			MaxDistance = FMath::Max(MaxDistance, Row[X]);
+		}
+	}
+	return MaxDistance;
+}
+#pragma endregion
+
+#pragma region Zone Index
+void FGridTopologyStore::BuildZoneIndex(int32 NumBands)
+{
+	// Per-band histograms: Counts[Band][Zone], with the border count in the Empty slot (Empty is never indexed)
+	NumBands = FMath::Clamp(NumBands, 1, FMath::Max(Size.Y, 1));
+	using FBandCounts = TStaticArray<int32, NumZones>;
+	TArray<FBandCounts, TInlineAllocator<16>> Counts;
+	Counts.SetNumZeroed(NumBands);
+	constexpr int32 BorderSlot = static_cast<int32>(ECellZone::Empty);
+
+	// Count pass
+	GridRowBands::ForEachBand(Size.Y, NumBands, [this, &Counts](int32 Band, int32 FirstRow, int32 EndRow)
+	{
+		FBandCounts& BandCounts = Counts[Band];
+		int32 NumBorder = 0;
+		for (int32 Index = FirstRow * Size.X; Index < EndRow * Size.X; ++Index)
+		{
+			++BandCounts[static_cast<int32>(Zones[Index])];
+			NumBorder += (WallMasks[Index] != 0);
+		}
+		BandCounts[BorderSlot] = NumBorder;
+	});
+
+	// Reduce: zone starts, then each band's first slot per zone (exclusive prefix over bands keeps row-major order)
+	ZoneStarts[0] = 0;
+	for (int32 Zone = 0; Zone < NumZones; ++Zone)
+	{
+		int32 Total = 0;
+		if (Zone != BorderSlot)
+		{
+			for (FBandCounts& BandCounts : Counts) { const int32 Count = BandCounts[Zone]; BandCounts[Zone] = ZoneStarts[Zone] + Total; Total += Count; }
+		}
+		ZoneStarts[Zone + 1] = ZoneStarts[Zone] + Total;
+	}
+
+	int32 NumBorder = 0;
+	for (FBandCounts& BandCounts : Counts) { const int32 Count = BandCounts[BorderSlot]; BandCounts[BorderSlot] = NumBorder; NumBorder += Count; }
+
+	ZoneCells.SetNumUninitialized(ZoneStarts[NumZones]);
+	BorderCells.SetNumUninitialized(NumBorder);
+
+	// Scatter pass: every band writes its own slot ranges (row-major within each zone)
+	GridRowBands::ForEachBand(Size.Y, NumBands, [this, &Counts](int32 Band, int32 FirstRow, int32 EndRow)
+	{
+		FBandCounts& Next = Counts[Band];
+		for (int32 Index = FirstRow * Size.X; Index < EndRow * Size.X; ++Index)
+		{
+			const int32 Zone = static_cast<int32>(Zones[Index]);
+			ZoneSlots[Index] = INDEX_NONE;
+			BorderSlots[Index] = INDEX_NONE;
+			if (Zone == static_cast<int32>(ECellZone::Empty)) continue;
+
+			const FIntPoint Cell = CellOf(Index);
+			ZoneSlots[Index] = Next[Zone];
+			ZoneCells[Next[Zone]++] = Cell;
+			if (WallMasks[Index] != 0)
+			{
+				BorderSlots[Index] = Next[BorderSlot];
+				BorderCells[Next[BorderSlot]++] = Cell;
+			}
+		}
+	});
+
+	bZoneIndexStale = false;
+}
+
+void FGridTopologyStore::AddToZoneIndex(int32 Index, ECellZone Zone)
+{
+	// Open a hole at the end, then shift every later bucket right by moving its first cell to its end
+	int32 Hole = ZoneCells.AddUninitialized();
+	++ZoneStarts[NumZones];
+	for (int32 Bucket = NumZones - 1; Bucket > static_cast<int32>(Zone); --Bucket)
+	{
+		const int32 First = ZoneStarts[Bucket];
+		if (First != Hole)
+		{
+			ZoneCells[Hole] = ZoneCells[First];
+			ZoneSlots[IndexOf(ZoneCells[Hole])] = Hole;
+		}
+		Hole = First;
+		ZoneStarts[Bucket] = First + 1;
+	}
+
+	ZoneCells[Hole] = CellOf(Index);
+	ZoneSlots[Index] = Hole;
+}
+
+void FGridTopologyStore::RemoveFromZoneIndex(int32 Index, ECellZone Zone)
+{
+	// Fill the hole with the bucket's last cell, then shift every later bucket left the same way
+	int32 Hole = ZoneSlots[Index];
+	check(Hole != INDEX_NONE);
+	for (int32 Bucket = static_cast<int32>(Zone); Bucket < NumZones; ++Bucket)
+	{
+		const int32 Last = ZoneStarts[Bucket + 1] - 1;
+		if (Last != Hole)
+		{
+			ZoneCells[Hole] = ZoneCells[Last];
+			ZoneSlots[IndexOf(ZoneCells[Hole])] = Hole;
+		}
+		Hole = Last;
+		ZoneStarts[Bucket + 1] = Last;
+	}
+
+	ZoneCells.Pop(EAllowShrinking::No);
+	ZoneSlots[Index] = INDEX_NONE;
+}
+
+void FGridTopologyStore::AddToBorderCells(int32 Index)
+{
+	BorderSlots[Index] = BorderCells.Add(CellOf(Index));
+}
+
+void FGridTopologyStore::RemoveFromBorderCells(int32 Index)
+{
+	const int32 Slot = BorderSlots[Index];
+	check(Slot != INDEX_NONE);
+	BorderCells.RemoveAtSwap(Slot, EAllowShrinking::No);
+	if (Slot < BorderCells.Num()) { BorderSlots[IndexOf(BorderCells[Slot])] = Slot; }
+	BorderSlots[Index] = INDEX_NONE;
+}
+
+void FGridTopologyStore::GetCellsByWallDistance(int32 MinDistance, int32 MaxDistance, TArray<FIntPoint>& OutCells) const
+{
+	const ECellZone* ZoneData = Zones.GetData();
+	const uint8* DistanceData = WallDistances.GetData();
+	for (int32 Index = 0; Index < Zones.Num(); ++Index)
+	{
+		const int32 Distance = DistanceData[Index];
+		if (Distance >= MinDistance && Distance <= MaxDistance && ZoneData[Index] != ECellZone::Empty) { OutCells.Add(CellOf(Index)); }
+	}
+}
+#pragma endregion
@@ -0,0 +1,72 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/RoomGridSnapshot.h"
+#include "Data/Grid/GridRunLengthCodec.h"
+
+FRoomGridSnapshotPtr FRoomGridSnapshot::Make(const FRoomGridSnapshotPtr& Previous, uint32 InVersion, FIntPoint InGridSize,
+	uint32 InGridRevision, TFunctionRef<void(TArray<EGridCellType>& OutCells)> CopyCells,
+	uint32 InTopologyRevision, TFunctionRef<void(TArray<ECellZone>& OutZones)> CopyZones)
+{
+	const bool bSameGrid = Previous.IsValid() && Previous->GridSize == InGridSize;
+
+	// Unchanged arrays are shared with the previous snapshot, changed ones copied fresh
+	TSharedPtr<const TArray<EGridCellType>, ESPMode::ThreadSafe> NewCells;
+	if (bSameGrid && Previous->GridRevision == InGridRevision) { NewCells = Previous->Cells; }
+	else
+	{
+		TSharedRef<TArray<EGridCellType>, ESPMode::ThreadSafe> Copy = MakeShared<TArray<EGridCellType>, ESPMode::ThreadSafe>();
+		CopyCells(*Copy);
+		NewCells = Copy;
+	}
+
+	TSharedPtr<const TArray<ECellZone>, ESPMode::ThreadSafe> NewZones;
+	if (bSameGrid && Previous->TopologyRevision == InTopologyRevision) { NewZones = Previous->Zones; }
+	else
+	{
+		TSharedRef<TArray<ECellZone>, ESPMode::ThreadSafe> Copy = MakeShared<TArray<ECellZone>, ESPMode::ThreadSafe>();
+		CopyZones(*Copy);
+		NewZones = Copy;
+	}
+
+	return FRoomGridSnapshotPtr(new FRoomGridSnapshot(InVersion, InGridSize, InGridRevision, NewCells.ToSharedRef(),
+		InTopologyRevision, NewZones.ToSharedRef()));
+}
+
+EGridCellType FRoomGridSnapshot::GetCellState(FIntPoint GridCoord) const
+{
+	if (!IsValidGridCoordinate(GridCoord) || Cells->Num() == 0) return EGridCellType::ECT_Empty;
+	return (*Cells)[GridCoord.Y * GridSize.X + GridCoord.X];
+}
+
+ECellZone FRoomGridSnapshot::GetCellZone(FIntPoint GridCoord) const
+{
+	if (!IsValidGridCoordinate(GridCoord) || !HasTopology()) return ECellZone::Empty;
+	return (*Zones)[GridCoord.Y * GridSize.X + GridCoord.X];
+}
+
+TArray<FIntPoint> FRoomGridSnapshot::GetCellsByZone(ECellZone Zone) const
+{
+	TArray<FIntPoint> Results;
+	if (!HasTopology()) return Results;
+
+	const ECellZone* ZoneData = Zones->GetData();
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			if (ZoneData[Y * GridSize.X + X] == Zone) { Results.Add(FIntPoint(X, Y)); }
+		}
+	}
+	return Results;
+}
+
+void FRoomGridSnapshot::Encode(TArray<uint8>& OutBytes) const
+{
+	const int32 NumCells = Cells->Num();
+	FGridRunLengthEncoder Encoder(OutBytes, NumCells > 0 ? GridSize : FIntPoint::ZeroValue, HasTopology());
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		Encoder.Push((*Cells)[Index], HasTopology() ? (*Zones)[Index] : ECellZone::Empty);
+	}
+	Encoder.Finish();
+}
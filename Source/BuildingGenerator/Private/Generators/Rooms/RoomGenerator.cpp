@@ -5,9 +5,13 @@
 #include "Data/Generation/RoomGenerationTypes.h"
 #include "Utilities/Generation/RoomGenerationHelpers.h" 
 #include "Data/Grid/GridData.h"
+#include "Data/Grid/GridFootprintKernels.h"
+#include "Data/Grid/GridRowBands.h"
+#include "Data/Grid/GridRunLengthCodec.h"
 #include "Data/Room/CeilingData.h"
 #include "Data/Room/DoorData.h"
 #include "Data/Room/WallData.h"
+#include "Misc/ScopeRWLock.h"
 
 bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
 {
@@ -41,9 +45,16 @@ void URoomGenerator::CreateGrid()
 
 	UE_LOG(LogTemp, Log, TEXT("UniformRoomGenerator: Creating uniform rectangular grid..."));
     
-	// Initialize grid state array (all floor cells for uniform room)
-	GridState.SetNum(GridSize.X * GridSize.Y);
-	for (EGridCellType& Cell : GridState) { Cell = EGridCellType::ECT_Empty; }
+	// Initialize chunked cell storage (all floor cells for uniform room, every chunk starts elided)
+	CellChunks.Init(GridSize, EGridCellType::ECT_Empty, GridMemoryLayout);
+	MarkGridChanged();
+
+	// Mirror into the cell type bitboard (every cell starts in the Empty plane, layer planes start clear)
+	CellTypeBoard.Init(GridSize, FGridBitboard::NumGridPlanes);
+	CellTypeBoard.FillPlane(FGridBitboard::PlaneOf(EGridCellType::ECT_Empty), true);
+	ChangeJournal.Reset();
+	MarkTopologyDirty(FIntRect(FIntPoint::ZeroValue, GridSize));
+	PublishSnapshot();
     
 	// Log statistics
 	int32 TotalCells = GetTotalCellCount();
@@ -52,12 +63,23 @@ void URoomGenerator::CreateGrid()
 
 void URoomGenerator:: ClearGrid()
 {
-	GridState.Empty();
+	CellChunks.Reset();
+	GridStateView.Empty();
+	MarkGridChanged();
+	CellTypeBoard.Reset();
+	ChangeJournal.Reset();
+	Connectivity.Reset();
+	WallContour.Reset();
+	{
+		FWriteScopeLock SnapshotWriteLock(SnapshotLock);
+		PublishedSnapshot.Reset();
+	}
 	PlacedFloorMeshes.Empty();
 	PlacedWallMeshes.Empty();
 	PlacedBaseWallSegments.Empty();
 	PlacedDoorwayMeshes.Empty();
 	PlacedCornerMeshes.Empty();
+	CornerMeshBatches.Empty();
 	PlacedCeilingTiles.Empty();
 
 	// Reset statistics
@@ -76,34 +98,65 @@ void URoomGenerator::ResetGridCellStates()
 	if (! bIsInitialized)
 	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::ResetGridCellStates - Not initialized! ")); return; }
 
-	// Reset only floor-placed cells back to their target type (preserves room shape)
-	int32 CellsReset = 0;
-	for (EGridCellType& Cell : GridState)
+	// Floor phases nothing later was journaled on top of roll back in O(placed cells); sections that wrote nothing are transparent
+	const int32 FloorPhase = ChangeJournal.FindLastPhase(EGridPhase::ForcedPlacement);
+	bool bFloorIsLatest = FloorPhase != INDEX_NONE;
+	for (int32 PhaseIndex = FloorPhase + 1; bFloorIsLatest && PhaseIndex < ChangeJournal.GetNumPhases(); ++PhaseIndex)
 	{
-		// ✅ Only reset cells that were filled with floor meshes
-		if (Cell == EGridCellType::ECT_FloorMesh)
-		{
-			Cell = FloorTargetCellType;  // Back to Empty (Uniform) or Custom (Chunky)
-			CellsReset++;
-		}
+		bFloorIsLatest = ChangeJournal.GetPhase(PhaseIndex) == EGridPhase::FloorFill || ChangeJournal.GetPhaseNumEntries(PhaseIndex) == 0;
 	}
+	if (bFloorIsLatest)
+	{
+		const int32 CellsRestored = RollbackPhase(EGridPhase::ForcedPlacement);
+		UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ResetGridCellStates - Rolled back %d floor cells (Total: %d)"), 
+			CellsRestored, GetTotalCellCount());
+		return;
+	}
+
+	// Reset only floor-placed cells back to their target type (preserves room shape), elided chunks retype in O(1)
+	const int32 CellsReset = CellChunks.ReplaceType(EGridCellType::ECT_FloorMesh, FloorTargetCellType);
+	MarkGridChanged();
+	MarkTopologyDirty(FIntRect(FIntPoint::ZeroValue, GridSize));
+
+	// Same retype on the bitboard, one word at a time
+	CellTypeBoard.MovePlaneInto(FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh), FGridBitboard::PlaneOf(FloorTargetCellType));
+
+	// The bulk retype is not journaled, so earlier entries no longer describe the grid
+	ChangeJournal.Reset();
 
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ResetGridCellStates - Reset %d cells to empty (Total: %d)"), 
-		CellsReset, GridState.Num());
+		CellsReset, GetTotalCellCount());
 }
 
 EGridCellType URoomGenerator:: GetCellState(FIntPoint GridCoord) const
 {
-	if (!IsValidGridCoordinate(GridCoord)) return EGridCellType::ECT_Empty;
-	int32 Index = GridCoordToIndex(GridCoord); return GridState[Index];
+	if (!IsValidGridCoordinate(GridCoord) || !CellChunks.IsInitialized()) return EGridCellType::ECT_Empty;
+	return CellChunks.GetCell(GridCoord.X, GridCoord.Y);
 }
 
-bool URoomGenerator::SetCellState(FIntPoint GridCoord, EGridCellType NewState)
+const TArray<EGridCellType>& URoomGenerator::GetGridState() const
 {
-	if (!IsValidGridCoordinate(GridCoord))	return false;
+	// Expand the chunks only when a caller needs the flat array (debug drawing, external tools)
+	if (bGridStateViewDirty)
+	{
+		if (CellChunks.IsInitialized()) { CellChunks.CopyTo(GridStateView); }
+		else { GridStateView.Reset(); }
+		bGridStateViewDirty = false;
+	}
+	return GridStateView;
+}
 
-	int32 Index = GridCoordToIndex(GridCoord);
-	GridState[Index] = NewState; return true;
+bool URoomGenerator::SetCellState(FIntPoint GridCoord, EGridCellType NewState)
+{
+	if (!IsValidGridCoordinate(GridCoord) || !CellChunks.IsInitialized()) return false;
+
+	const EGridCellType OldState = CellChunks.GetCell(GridCoord.X, GridCoord.Y);
+	if (OldState == NewState) return true;
+	if (ChangeJournal.IsRecording()) { ChangeJournal.RecordUniform(GridCoord, FIntPoint(1, 1), OldState); }
+	CellTypeBoard.SetCellType(GridCoord.X, GridCoord.Y, OldState, NewState);
+	CellChunks.SetCell(GridCoord.X, GridCoord.Y, NewState);
+	MarkTopologyDirty(FIntRect(GridCoord, GridCoord + FIntPoint(1, 1)));
+	MarkGridChanged(); return true;
 }
 
 bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const
@@ -113,17 +166,25 @@ bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const
 
 bool URoomGenerator::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const
 {
-	// Delegate to static helper
-	return URoomGenerationHelpers::IsAreaAvailable(GridState, GridSize, StartCoord, Size, FloorTargetCellType);
+	if (!IsValidGridCoordinate(StartCoord) || Size.X <= 0 || Size.Y <= 0) return false;
+	if (StartCoord.X + Size.X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y) return false;
+	if (!CellTypeBoard.IsInitialized()) return false;
+
+	// Ladder footprints: unrolled mask test on the free-cell plane
+	const int32 FreePlane = FGridBitboard::PlaneOf(FloorTargetCellType);
+	if (const FGridFootprintKernel* Kernel = FGridFootprintKernel::Find(Size)) return Kernel->IsSet(CellTypeBoard, FreePlane, StartCoord.X, StartCoord.Y);
+
+	// Any other footprint: one span mask test per row word of the free-cell plane
+	return CellTypeBoard.IsRectSet(FreePlane, StartCoord.X, StartCoord.Y, Size.X, Size.Y);
 }
 
 bool URoomGenerator::MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType)
 {
 	// Check availability using helper
-	if (!URoomGenerationHelpers::IsAreaAvailable(GridState, GridSize, StartCoord, Size, EGridCellType::ECT_Empty)) return false;
+	if (!URoomGenerationHelpers::IsAreaAvailableInBitboard(CellTypeBoard, StartCoord, Size, EGridCellType::ECT_Empty)) return false;
 
-	// Mark cells using helper
-	URoomGenerationHelpers:: MarkCellsOccupied(GridState, GridSize, StartCoord, Size, CellType); return true;
+	// Mark cells
+	WriteCells(StartCoord, Size, CellType); return true;
 }
 
 bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size)
@@ -131,11 +192,171 @@ bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size)
 	// Validate coordinates
 	if (StartCoord.X + Size.X > GridSize.X || StartCoord. Y + Size.Y > GridSize.Y) return false;
 
-	// Use helper to clear (mark as Empty)
-	URoomGenerationHelpers::MarkCellsOccupied(GridState, GridSize, StartCoord, Size, EGridCellType:: ECT_Empty); 
+	// Clear (mark as Empty)
+	WriteCells(StartCoord, Size, EGridCellType::ECT_Empty);
 	return true;
 }
 
+void URoomGenerator::WriteCells(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType)
+{
+	// Clip to grid
+	const int32 MinX = FMath::Max(StartCoord.X, 0);
+	const int32 MinY = FMath::Max(StartCoord.Y, 0);
+	const int32 MaxX = FMath::Min(StartCoord.X + Size.X, GridSize.X);
+	const int32 MaxY = FMath::Min(StartCoord.Y + Size.Y, GridSize.Y);
+	if (MinX >= MaxX || MinY >= MaxY || !CellTypeBoard.IsInitialized()) return;
+
+	// Rewriting a rect with the type it already holds changes nothing and is not journaled
+	const FIntPoint ClippedSize(MaxX - MinX, MaxY - MinY);
+	if (CellTypeBoard.IsRectSet(FGridBitboard::PlaneOf(CellType), MinX, MinY, ClippedSize.X, ClippedSize.Y)) return;
+	MarkGridChanged();
+	MarkTopologyDirty(FIntRect(MinX, MinY, MaxX, MaxY));
+
+	const int32 FreePlane = FGridBitboard::PlaneOf(FloorTargetCellType);
+
+	// Placement fast path: a ladder footprint over free cells retypes with the specialized kernel
+	if (const FGridFootprintKernel* Kernel = FGridFootprintKernel::Find(ClippedSize);
+		Kernel && CellType != FloorTargetCellType && Kernel->IsSet(CellTypeBoard, FreePlane, MinX, MinY))
+	{
+		if (ChangeJournal.IsRecording()) { ChangeJournal.RecordUniform(FIntPoint(MinX, MinY), ClippedSize, FloorTargetCellType); }
+		Kernel->Retype(CellTypeBoard, FreePlane, FGridBitboard::PlaneOf(CellType), MinX, MinY);
+		CellChunks.FillRect(MinX, MinY, ClippedSize.X, ClippedSize.Y, CellType);
+		return;
+	}
+
+	// Journal the previous cells (free rects are known uniform, others are read back and collapsed when uniform)
+	if (ChangeJournal.IsRecording())
+	{
+		if (CellTypeBoard.IsRectSet(FreePlane, MinX, MinY, ClippedSize.X, ClippedSize.Y)) { ChangeJournal.RecordUniform(FIntPoint(MinX, MinY), ClippedSize, FloorTargetCellType); }
+		else { ChangeJournal.RecordCells(FIntPoint(MinX, MinY), ClippedSize, CellChunks); }
+	}
+
+	CellTypeBoard.SetRectType(MinX, MinY, ClippedSize.X, ClippedSize.Y, CellType);
+	CellChunks.FillRect(MinX, MinY, ClippedSize.X, ClippedSize.Y, CellType);
+}
+
+int32 URoomGenerator::WriteCellList(TConstArrayView<FIntPoint> Cells, EGridCellType CellType)
+{
+	if (!CellChunks.IsInitialized() || !CellTypeBoard.IsInitialized()) return 0;
+
+	// Per cell: journal, bit planes and chunks; bounds of the changed cells feed one topology dirty rect
+	FIntPoint BoundsMin = GridSize, BoundsMax = FIntPoint::ZeroValue;
+	int32 NumChanged = 0;
+	for (const FIntPoint& Cell : Cells)
+	{
+		if (!IsValidGridCoordinate(Cell)) continue;
+		const EGridCellType OldType = CellChunks.GetCell(Cell.X, Cell.Y);
+		if (OldType == CellType) continue;
+
+		if (ChangeJournal.IsRecording()) { ChangeJournal.RecordUniform(Cell, FIntPoint(1, 1), OldType); }
+		CellTypeBoard.SetCellType(Cell.X, Cell.Y, OldType, CellType);
+		CellChunks.SetCell(Cell.X, Cell.Y, CellType);
+		BoundsMin = BoundsMin.ComponentMin(Cell);
+		BoundsMax = BoundsMax.ComponentMax(Cell + FIntPoint(1, 1));
+		++NumChanged;
+	}
+	if (NumChanged == 0) return 0;
+
+	MarkGridChanged();
+	MarkTopologyDirty(FIntRect(BoundsMin, BoundsMax));
+	return NumChanged;
+}
+
+int32 URoomGenerator::RollbackPhase(EGridPhase Phase)
+{
+	const int32 PhaseIndex = ChangeJournal.FindLastPhase(Phase);
+	if (PhaseIndex == INDEX_NONE) return INDEX_NONE;
+
+	// Floor meshes are only appended while phases run, so the count at phase start is the cut
+	const int32 NumFloorMeshes = FMath::Min(ChangeJournal.GetPhaseRecordMark(PhaseIndex), PlacedFloorMeshes.Num());
+	PlacedFloorMeshes.SetNum(NumFloorMeshes);
+
+	// Restores go through WriteCells so chunks and planes stay in sync (the journal pauses itself)
+	return ChangeJournal.Rewind(PhaseIndex, [this](FIntPoint Start, FIntPoint Size, EGridCellType Type) { WriteCells(Start, Size, Type); });
+}
+
+FRoomGridSnapshotPtr URoomGenerator::GetSnapshot() const
+{
+	FReadScopeLock SnapshotReadLock(SnapshotLock);
+	return PublishedSnapshot;
+}
+
+void URoomGenerator::PublishSnapshot()
+{
+	// Built outside the lock: readers keep using the previous snapshot until the pointer swap
+	const FRoomGridSnapshotPtr Previous = GetSnapshot();
+	FRoomGridSnapshotPtr Next = FRoomGridSnapshot::Make(Previous, ++SnapshotVersion, GridSize,
+		GridRevision, [this](TArray<EGridCellType>& OutCells)
+		{
+			if (CellChunks.IsInitialized()) { CellChunks.CopyTo(OutCells); }
+		},
+		TopologyRevision, [this](TArray<ECellZone>& OutZones)
+		{
+			if (!bTopologyAnalyzed || CellTopology.GetSize() != GridSize) return;
+			OutZones = CellTopology.GetZones();
+		});
+
+	FWriteScopeLock SnapshotWriteLock(SnapshotLock);
+	PublishedSnapshot = MoveTemp(Next);
+}
+
+void URoomGenerator::EncodeGridState(TArray<uint8>& OutBytes) const
+{
+	// Streamed straight from the chunks (no flat copy); zones read from the dense topology store
+	const bool bWithZones = bTopologyAnalyzed && CellChunks.IsInitialized() && CellTopology.GetSize() == GridSize;
+	FGridRunLengthEncoder Encoder(OutBytes, CellChunks.IsInitialized() ? GridSize : FIntPoint::ZeroValue, bWithZones);
+	if (!CellChunks.IsInitialized()) { Encoder.Finish(); return; }
+
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			Encoder.Push(CellChunks.GetCell(X, Y), bWithZones ? CellTopology.GetZone(Y * GridSize.X + X) : ECellZone::Empty);
+		}
+	}
+	Encoder.Finish();
+}
+
+bool URoomGenerator::DecodeGridState(TConstArrayView<uint8> Bytes)
+{
+	if (!CellChunks.IsInitialized()) return false;
+
+	// Validation pass first so a bad stream never leaves a half-written grid
+	FGridRunLengthDecoder Validator(Bytes);
+	if (!Validator.ReadHeader() || Validator.GetGridSize() != GridSize)
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::DecodeGridState - Header invalid or grid size mismatch")); return false; }
+
+	EGridCellType CellType;
+	ECellZone Zone;
+	int32 Count;
+	while (Validator.NextRun(CellType, Zone, Count)) {}
+	if (!Validator.IsComplete())
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::DecodeGridState - Malformed run data")); return false; }
+
+	// Loaded cells are a new baseline, not an undoable phase
+	ChangeJournal.Reset();
+
+	// Write pass: each run as one row-span WriteCells per row it covers
+	FGridRunLengthDecoder Decoder(Bytes);
+	Decoder.ReadHeader();
+	int32 X = 0, Y = 0;
+	while (Decoder.NextRun(CellType, Zone, Count))
+	{
+		while (Count > 0)
+		{
+			const int32 Span = FMath::Min(Count, GridSize.X - X);
+			WriteCells(FIntPoint(X, Y), FIntPoint(Span, 1), CellType);
+			Count -= Span;
+			X += Span;
+			if (X == GridSize.X) { X = 0; ++Y; }
+		}
+	}
+
+	// Zones are derived data: re-analysis restores the full metadata (and publishes), otherwise publish the cells alone
+	if (Decoder.HasZones()) { AnalyzeTopology(); }
+	else { PublishSnapshot(); }
+	return true;
+}
 
 
 
@@ -170,39 +391,33 @@ bool URoomGenerator::GenerateFloor()
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateFloor - Starting floor generation"));
 
  
-	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved)
- 	TArray<FIntPoint> ForcedEmptyCells = ExpandForcedEmptyRegions();
-	if (ForcedEmptyCells.Num() > 0)
+	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved, a regeneration continues the section its rollback left current)
+	ChangeJournal.ContinuePhase(EGridPhase::ForcedEmpty, PlacedFloorMeshes.Num());
+ 	const int32 ForcedEmptyCount = MarkForcedEmptyAreas();
+	if (ForcedEmptyCount > 0)
 	{
-		MarkForcedEmptyCells(ForcedEmptyCells);
-		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCells. Num());
+		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCount);
 	}
 	
 	// PHASE 1: FORCED PLACEMENTS (Designer overrides - highest priority)
+	ChangeJournal.BeginPhase(EGridPhase::ForcedPlacement, PlacedFloorMeshes.Num());
  	int32 ForcedCount = ExecuteForcedPlacements();
 	UE_LOG(LogTemp, Log, TEXT("  Phase 1: Placed %d forced meshes"), ForcedCount);
 	
-	// PHASE 2: GREEDY FILL (Large → Medium → Small)
- 	// Use the FloorData pointer we loaded at the top (safer than re-accessing)
 	const TArray<FMeshPlacementInfo>& FloorMeshes = FloorStyleData->FloorTilePool;
-	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), FloorMeshes.Num());
-
-	// Large tiles (400x400, 200x400, 400x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-
-	// Medium tiles (200x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-
-	// Small tiles (100x200, 200x100, 100x100)
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	
-	// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
-	int32 GapFillCount = FillRemainingGaps(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
+	ChangeJournal.BeginPhase(EGridPhase::FloorFill, PlacedFloorMeshes.Num());
+	if (FloorStyleData->TilingMode == EFloorTilingMode::Hierarchical)
+	{
+		// PHASE 2: HIERARCHICAL FILL (4x4 blocks subdivided down to 1x1 in a single pass)
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Hierarchical fill with %d tile options"), FloorMeshes.Num());
+		int32 HierarchicalCount = FillFloorHierarchical(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Placed %d meshes"), HierarchicalCount);
+	}
+	else
+	{
+		// PHASE 2 + 3: GREEDY FILL (Large → Medium → Small) then GAP FILL
+		FillFloorGreedy(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	}
  
 	// FINAL STATISTICS
 	int32 RemainingEmpty = GetCellCountByType(EGridCellType::ECT_Empty);
@@ -212,6 +427,7 @@ bool URoomGenerator::GenerateFloor()
 		FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 	UE_LOG(LogTemp, Log, TEXT("  Remaining empty cells: %d"), RemainingEmpty);
 
+	PublishSnapshot();
 	return true;
 }
 void URoomGenerator::ClearPlacedFloorMeshes()
@@ -238,6 +454,7 @@ int32 URoomGenerator::ExecuteForcedPlacements()
 
 	int32 SuccessfulPlacements = 0;
 	const TMap<FIntPoint, FMeshPlacementInfo>& ForcedPlacements = RoomData->ForcedFloorPlacements;
+	FFloorPlacementEngine Engine = MakeFloorPlacementEngine();
 
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedPlacements - Processing %d forced placements"), ForcedPlacements. Num());
 	for (const auto& Pair : ForcedPlacements)
@@ -252,82 +469,19 @@ int32 URoomGenerator::ExecuteForcedPlacements()
 			continue;
 		}
 
-		// Calculate original footprint
-		FIntPoint OriginalFootprint = CalculateFootprint(MeshInfo);
-
-		UE_LOG(LogTemp, Verbose, TEXT("  Attempting forced placement at (%d,%d) with footprint %dx%d"), 
-		StartCoord.X, StartCoord.Y, OriginalFootprint.X, OriginalFootprint.Y);
-
-		// Try to find a rotation that fits the available space
-		int32 BestRotation = -1;
-		FIntPoint BestFootprint;
-
-		if (MeshInfo.AllowedRotations.Num() > 0)
-		{
-			// Try each allowed rotation to find one that fits
-			for (int32 Rotation :  MeshInfo.AllowedRotations)
-			{
-				FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-				// Check if this rotation fits within grid bounds
-				if (StartCoord.X + RotatedFootprint.X <= GridSize. X && StartCoord.Y + RotatedFootprint.Y <= GridSize.Y)
-				{
-					// Check if area is available
-					if (IsAreaAvailable(StartCoord, RotatedFootprint))
-					{
-						BestRotation = Rotation;
-						BestFootprint = RotatedFootprint;
-						UE_LOG(LogTemp, Verbose, TEXT("    Found valid rotation %d° (footprint %dx%d)"), 
-							Rotation, RotatedFootprint.X, RotatedFootprint.Y);
-						break; // Use first valid rotation
-					}
-				}
-			}
-		}
-		else
-		{
-			// No allowed rotations defined, try default (0°)
-			BestRotation = 0;
-			BestFootprint = OriginalFootprint;
-		}
-
-		// Check if we found a valid rotation
-		if (BestRotation == -1)
+		// Place with the first allowed rotation (0° if none) whose footprint is inside the grid and free
+		FIntPoint PlacedFootprint;
+		const int32 PlacedRotation = Engine.TryPlaceForced(StartCoord, MeshInfo, MeshInfo.AllowedRotations, PlacedFootprint);
+		if (PlacedRotation == INDEX_NONE)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) cannot fit with any allowed rotation - skipping"), 
 				StartCoord.X, StartCoord.Y);
 			continue;
 		}
 
-		// Validate bounds with best rotation
-		if (StartCoord.X + BestFootprint.X > GridSize.X || 
-		    StartCoord.Y + BestFootprint. Y > GridSize.Y)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) is out of bounds (size %dx%d) - skipping"), 
-				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y);
-			continue;
-		}
-
-		// Final check if area is available
-		if (! IsAreaAvailable(StartCoord, BestFootprint))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) overlaps existing placement - skipping"), 
-				StartCoord.X, StartCoord.Y);
-			continue;
-		}
-
-		// Place the mesh with best rotation
-		if (TryPlaceMesh(StartCoord, BestFootprint, MeshInfo, BestRotation))
-		{
-			SuccessfulPlacements++;
-			UE_LOG(LogTemp, Log, TEXT("  ✓ Placed forced mesh at (%d,%d) size %dx%d rotation %d°"), 
-				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y, BestRotation);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Failed to place forced mesh at (%d,%d) - TryPlaceMesh returned false"), 
-				StartCoord.X, StartCoord.Y);
-		}
+		SuccessfulPlacements++;
+		UE_LOG(LogTemp, Log, TEXT("  ✓ Placed forced mesh at (%d,%d) size %dx%d rotation %d°"), 
+			StartCoord.X, StartCoord.Y, PlacedFootprint.X, PlacedFootprint.Y, PlacedRotation);
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedPlacements - Placed %d/%d forced meshes"), 
@@ -339,164 +493,101 @@ int32 URoomGenerator::ExecuteForcedPlacements()
 int32 URoomGenerator::FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool,
 int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
 {
-if (TilePool.Num() == 0)
+	if (TilePool.Num() == 0)
 	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator:: FillRemainingGaps - No meshes in tile pool! ")); return 0;}
 
-	int32 PlacedCount = 0;
-
-	// Define sizes to try (largest to smallest for efficiency)
-	TArray<FIntPoint> SizesToTry = {
-		FIntPoint(1, 4), // 100x400
-		FIntPoint(4, 1), // 400x100
-		FIntPoint(1, 2), // 100x200
-		FIntPoint(2, 1), // 200x100
-		FIntPoint(1, 1)  // 100x100
-	};
-
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Starting gap fill"));
 
-	// Try each size in order
-	for (const FIntPoint& TargetSize : SizesToTry)
-	{
-		// Filter tiles that match this size
-		TArray<FMeshPlacementInfo> MatchingTiles;
-
-		for (const FMeshPlacementInfo& MeshInfo : TilePool)
-		{
-			FIntPoint Footprint = CalculateFootprint(MeshInfo);
+	// Gap ladder (1x4, 4x1, 1x2, 2x1, 1x1) over every remaining free anchor
+	FFloorPlacementEngine Engine = MakeFloorPlacementEngine();
+	const int32 PlacedCount = Engine.FillLadder(TilePool, FRoomPlacement::GapLadder, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
 
-			// Check if footprint matches target size (or rotated version)
-			if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) || (Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
-			{
-				MatchingTiles.Add(MeshInfo);
-			}
-		}
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Placed %d gap-fill meshes"), PlacedCount);
 
-		if (MatchingTiles.Num() == 0) continue; // No tiles of this size, try next
+	return PlacedCount;
+}
 
-		int32 SizePlacedCount = 0;
+TArray<FIntPoint> URoomGenerator::ExpandForcedEmptyRegions() const
+{
+	TArray<FIntPoint> ExpandedCells;
 
-		// Try to place tiles of this size in all empty spaces
-		for (int32 Y = 0; Y < GridSize.Y; ++Y)
-		{
-			for (int32 X = 0; X < GridSize.X; ++X)
-			{
-				FIntPoint StartCoord(X, Y);
+	if (! RoomData || GridSize.X <= 0 || GridSize.Y <= 0) return ExpandedCells;
 
-				// Check if area is available
-				if (IsAreaAvailable(StartCoord, TargetSize))
-				{
-					// Select weighted random mesh
-					FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-					FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-					// Find rotation that matches target size
-					int32 BestRotation = 0;
-					
-					if (SelectedMesh.AllowedRotations.Num() > 0)
-					{
-						// Build list of rotations that would fit the target size
-						TArray<int32> ValidRotations;
-
-						for (int32 Rotation : SelectedMesh.AllowedRotations)
-						{
-							FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-							
-							if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-							{
-								ValidRotations.Add(Rotation);
-							}
-						}
-
-						// Select random rotation from valid options
-						if (ValidRotations.Num() > 0)
-						{
-							int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-							BestRotation = ValidRotations[RandomIndex];
-						}
-					}
-
-					// Try to place mesh with rotation
-					if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-					{
-						SizePlacedCount++;
-						PlacedCount++;
-
-						// Update statistics
-						int32 TileArea = TargetSize.X * TargetSize.Y;
-						if (TileArea >= 16) OutLargeTiles++;
-						else if (TileArea >= 4) OutMediumTiles++;
-						else if (TileArea >= 2) OutSmallTiles++;
-						else OutFillerTiles++;
-					}
-				}
-			}
-		}
+	// Regions and cells are deduplicated by the mask, then read back one set bit at a time
+	FGridBitboard ForcedEmptyMask;
+	ForcedEmptyMask.Init(GridSize, 1);
+	BuildForcedEmptyMask(ForcedEmptyMask, 0);
+	ExpandedCells.Reserve(ForcedEmptyMask.CountSet(0));
 
-		if (SizePlacedCount > 0)
-		{
-			UE_LOG(LogTemp, Verbose, TEXT("  Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize. X, TargetSize.Y);
-		}
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = ForcedEmptyMask.FindNextSet(0, Y, 0); X != INDEX_NONE; X = ForcedEmptyMask.FindNextSet(0, Y, X + 1))
+		{ ExpandedCells.Add(FIntPoint(X, Y)); }
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Placed %d gap-fill meshes"), PlacedCount);
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: ExpandForcedEmptyRegions - Expanded to %d cells"), ExpandedCells.Num());
 
-	return PlacedCount;
+	return ExpandedCells;
 }
 
-TArray<FIntPoint> URoomGenerator::ExpandForcedEmptyRegions() const
+void URoomGenerator::BuildForcedEmptyMask(FGridBitboard& OutMask, int32 Plane) const
 {
-	TArray<FIntPoint> ExpandedCells;
-
-	if (! RoomData) return ExpandedCells;
+	OutMask.FillPlane(Plane, false);
+	if (!RoomData || GridSize.X <= 0 || GridSize.Y <= 0) return;
 
-	// 1. Expand all rectangular regions into individual cells
+	// 1. Rectangular regions
 	for (const FForcedEmptyRegion& Region : RoomData->ForcedEmptyRegions)
 	{
-		// Calculate bounding box (handles any corner order)
-		int32 MinX = FMath::Min(Region.StartCell.X, Region.EndCell. X);
-		int32 MaxX = FMath::Max(Region.StartCell.X, Region.EndCell.X);
-		int32 MinY = FMath::Min(Region.StartCell.Y, Region.EndCell. Y);
-		int32 MaxY = FMath::Max(Region.StartCell.Y, Region.EndCell.Y);
-
-		// Clamp to valid grid bounds
-		MinX = FMath:: Clamp(MinX, 0, GridSize.X - 1);
-		MaxX = FMath::Clamp(MaxX, 0, GridSize.X - 1);
-		MinY = FMath::Clamp(MinY, 0, GridSize.Y - 1);
-		MaxY = FMath:: Clamp(MaxY, 0, GridSize.Y - 1);
-
-		// Add all cells within the rectangular region
-		for (int32 Y = MinY; Y <= MaxY; ++Y)
-		{
-			for (int32 X = MinX; X <= MaxX; ++X)
-			{
-				FIntPoint Cell(X, Y);
-				ExpandedCells.AddUnique(Cell); // AddUnique prevents duplicates
-			}
-		}
+		FIntPoint Start, Size;
+		GetForcedEmptyRegionRect(Region, Start, Size);
+		OutMask.SetRect(Plane, Start.X, Start.Y, Size.X, Size.Y, true);
 	}
 
-	// 2. Add individual forced empty cells
+	// 2. Individual forced empty cells (within grid bounds)
 	for (const FIntPoint& Cell : RoomData->ForcedEmptyFloorCells)
 	{
-		// Validate cell is within grid bounds
-		if (Cell.X >= 0 && Cell.X < GridSize.X && Cell.Y >= 0 && Cell.Y < GridSize.Y) {	ExpandedCells.AddUnique(Cell); }
+		if (IsValidGridCoordinate(Cell)) { OutMask.SetBit(Plane, Cell.X, Cell.Y, true); }
 	}
+}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: ExpandForcedEmptyRegions - Expanded to %d cells"), ExpandedCells.Num());
-
-	return ExpandedCells;
+void URoomGenerator::GetForcedEmptyRegionRect(const FForcedEmptyRegion& Region, FIntPoint& OutStart, FIntPoint& OutSize) const
+{
+	// Corners in any order, clamped to valid grid bounds
+	OutStart = FIntPoint(FMath::Clamp(FMath::Min(Region.StartCell.X, Region.EndCell.X), 0, GridSize.X - 1),
+		FMath::Clamp(FMath::Min(Region.StartCell.Y, Region.EndCell.Y), 0, GridSize.Y - 1));
+	const FIntPoint End(FMath::Clamp(FMath::Max(Region.StartCell.X, Region.EndCell.X), 0, GridSize.X - 1),
+		FMath::Clamp(FMath::Max(Region.StartCell.Y, Region.EndCell.Y), 0, GridSize.Y - 1));
+	OutSize = End - OutStart + FIntPoint(1, 1);
 }
 
-void URoomGenerator::MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells)
+int32 URoomGenerator::MarkForcedEmptyAreas()
 {
-	for (const FIntPoint& Cell :  EmptyCells)
+	if (!RoomData || !CellTypeBoard.IsInitialized()) return 0;
+	if (RoomData->ForcedEmptyRegions.Num() == 0 && RoomData->ForcedEmptyFloorCells.Num() == 0) return 0;
+
+	// Regions: one rect write each, overlapping regions just rewrite the same cells
+	for (const FForcedEmptyRegion& Region : RoomData->ForcedEmptyRegions)
 	{
-		// Mark as Wall type (reserved/boundary marker)
-		SetCellState(Cell, EGridCellType::ECT_WallMesh);
+		FIntPoint Start, Size;
+		GetForcedEmptyRegionRect(Region, Start, Size);
+		WriteCells(Start, Size, EGridCellType::ECT_WallMesh);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::MarkForcedEmptyCells - Marked %d cells as empty"), EmptyCells.Num());
+	// Individual cells: O(cells) writes, one table rebuild
+	MarkForcedEmptyCells(RoomData->ForcedEmptyFloorCells);
+
+	// Kept in the reserved layer; the distinct cell count is its popcount instead of a per-cell uniqueness search
+	const int32 ReservedPlane = FGridBitboard::PlaneOf(EGridLayer::Reserved);
+	BuildForcedEmptyMask(CellTypeBoard, ReservedPlane);
+	return CellTypeBoard.CountSet(ReservedPlane);
+}
+
+void URoomGenerator::MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells)
+{
+	// Mark as Wall type (reserved/boundary marker), as one batch
+	const int32 NumChanged = WriteCellList(EmptyCells, EGridCellType::ECT_WallMesh);
+
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::MarkForcedEmptyCells - Marked %d cells as empty (%d changed)"), EmptyCells.Num(), NumChanged);
 }
 
 
@@ -532,11 +623,21 @@ bool URoomGenerator::GenerateWalls()
 	int32 ForcedCount = ExecuteForcedWallPlacements();
 	if (ForcedCount > 0) UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced walls"), ForcedCount);
 	
-	// PHASE 2: Generate base walls for each edge
-	FillWallEdge(EWallEdge::North);
-	FillWallEdge(EWallEdge::South);
-	FillWallEdge(EWallEdge::East);
-	FillWallEdge(EWallEdge::West);
+	// PHASE 2: Generate base walls along the room outline (cells that are not forced empty or void)
+	if (TraceRoomOutline())
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Outline has %d runs in %d loop(s), perimeter %d cells"),
+			WallContour.GetRuns().Num(), WallContour.GetNumLoops(), WallContour.GetPerimeter());
+
+		for (const FGridContourRun& Run : WallContour.GetRuns()) { FillWallRun(Run); }
+	}
+	else
+	{
+		FillWallEdge(EWallEdge::North);
+		FillWallEdge(EWallEdge::South);
+		FillWallEdge(EWallEdge::East);
+		FillWallEdge(EWallEdge::West);
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateWalls - Base walls tracked:  %d segments"), PlacedBaseWallSegments.Num());
 
@@ -640,6 +741,7 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 		// TRACKING: Store Segment for Middle/Top Spawning
 		FGeneratorWallSegment Segment;
 		Segment.Edge = ForcedWall.Edge;
+		Segment.Line = URoomGenerationHelpers::GetEdgeLine(ForcedWall.Edge, GridSize);
 		Segment.StartCell = ForcedWall.StartCell;
 		Segment. SegmentLength = Footprint;
 		Segment.BaseTransform = BaseTransform;
@@ -658,12 +760,24 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 	return SuccessfulPlacements;
 }
 
-bool URoomGenerator::IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const
+bool URoomGenerator::TraceRoomOutline()
+{
+	if (!CellTypeBoard.IsInitialized()) { WallContour.Reset(); return false; }
+
+	FGridBitboard RoomMask;
+	RoomMask.Init(GridSize, 1);
+	const int32 OutsidePlanes[] = { FGridBitboard::PlaneOf(EGridCellType::ECT_WallMesh), FGridBitboard::PlaneOf(EGridCellType::ECT_Void) };
+	RoomMask.CopyPlaneUnion(0, CellTypeBoard, OutsidePlanes, true);
+	WallContour.Trace(RoomMask, 0);
+	return true;
+}
+
+bool URoomGenerator::IsCellRangeOccupied(EWallEdge Edge, int32 Line, int32 StartCell, int32 Length) const
 {
 	// Check if any forced wall overlaps with this range
 	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
 	{
-		if (Segment.Edge != Edge) continue;
+		if (Segment.Edge != Edge || Segment.Line != Line) continue;
 
 		// Check for overlap:  [Start1, End1) overlaps [Start2, End2) if Start1 < End2 AND Start2 < End1
 		int32 SegmentEnd = Segment.StartCell + Segment.SegmentLength;
@@ -825,76 +939,77 @@ bool URoomGenerator::GenerateCorners()
     if (!CornerMesh)
     { UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCorners - Failed to load corner mesh")); return false;		}
 
-     
-    // Define corner data (matching MasterRoom's clockwise order:  SW, SE, NE, NW)
-	struct FCornerData
+
+    // Inner corners get their own mesh when one is assigned
+    TSoftObjectPtr<UStaticMesh> InnerMesh = WallData->DefaultCornerMesh;
+    if (!WallData->InnerCornerMesh.IsNull())
     {
-        ECornerPosition Position;
-        FVector BasePosition;  // Grid corner position (before offset)
-        FRotator Rotation;     // From WallData
-        FVector Offset;        // Per-corner offset from WallData
-        FString Name;          // For logging
-    };
-
-    TArray<FCornerData> Corners = {
-        { 
-            ECornerPosition::SouthWest, 
-            FVector(0.0f, 0.0f, 0.0f),  // Bottom-left
-            WallData->SouthWestCornerRotation, 
-            WallData->SouthWestCornerOffset,
-            TEXT("SouthWest")
-        },
-        { 
-            ECornerPosition::SouthEast, 
-            FVector(0.0f, GridSize.Y * CellSize, 0.0f),  // Bottom-right
-            WallData->SouthEastCornerRotation, 
-            WallData->SouthEastCornerOffset,
-            TEXT("SouthEast")
-        },
-        { 
-            ECornerPosition::NorthEast, 
-            FVector(GridSize.X * CellSize, GridSize.Y * CellSize, 0.0f),  // Top-right
-            WallData->NorthEastCornerRotation, 
-            WallData->NorthEastCornerOffset,
-            TEXT("NorthEast")
-        },
-        { 
-            ECornerPosition:: NorthWest, 
-            FVector(GridSize.X * CellSize, 0.0f, 0.0f),  // Top-left
-            WallData->NorthWestCornerRotation, 
-            WallData->NorthWestCornerOffset,
-            TEXT("NorthWest")
-        }
-    };
-     
-    // Generate each corner
-    for (const FCornerData& CornerData : Corners)
+        if (WallData->InnerCornerMesh.LoadSynchronous()) { InnerMesh = WallData->InnerCornerMesh; }
+        else { UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCorners - Failed to load inner corner mesh, using default")); }
+    }
+
+    // Re-trace (linear) rather than reuse the walls' outline: the grid may have been written since GenerateWalls
+    if (!TraceRoomOutline())
+    { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCorners - Grid not created!")); return false; }
+
+    // Per-corner rotation and designer offset from WallData, indexed by ECornerPosition (SW, SE, NE, NW)
+    const FRotator Rotations[] = { WallData->SouthWestCornerRotation, WallData->SouthEastCornerRotation,
+        WallData->NorthEastCornerRotation, WallData->NorthWestCornerRotation };
+    const FVector Offsets[] = { WallData->SouthWestCornerOffset, WallData->SouthEastCornerOffset,
+        WallData->NorthEastCornerOffset, WallData->NorthWestCornerOffset };
+
+    // Outer corners first, then inner ones, so each mesh's records are one contiguous batch
+    for (const bool bInner : { false, true })
     {
-        // Apply designer offset to base position
-        FVector FinalPosition = CornerData. BasePosition + CornerData. Offset;
+        const TSoftObjectPtr<UStaticMesh>& Mesh = bInner ? InnerMesh : WallData->DefaultCornerMesh;
+        const int32 FirstCorner = PlacedCornerMeshes.Num();
 
-        // Create transform (local/component space)
-        FTransform CornerTransform(CornerData.Rotation, FinalPosition, FVector:: OneVector);
+        for (const FGridContourCorner& Corner : WallContour.GetCorners())
+        {
+            if (Corner.bConvex == bInner) continue;
+
+            // Labelled by the two walls meeting at the vertex (an inner corner shares its walls' facing with the outer one)
+            const ECornerPosition Position = URoomGenerationHelpers::GetCornerPositionForSides(Corner.GetSideAlongY(), Corner.GetSideAlongX());
+            const int32 Slot = static_cast<int32>(Position);
+
+            // Apply designer offset to the vertex position, mirrored in the plane for inner corners so it does not push into the floor
+            const FVector& Offset = Offsets[Slot];
+            const FVector CornerOffset = bInner ? FVector(-Offset.X, -Offset.Y, Offset.Z) : Offset;
+            FVector FinalPosition = FVector(Corner.Vertex.X * CellSize, Corner.Vertex.Y * CellSize, 0.0f) + CornerOffset;
+
+            // Create placed corner info (local/component space)
+            FPlacedCornerInfo& PlacedCorner = PlacedCornerMeshes.AddDefaulted_GetRef();
+            PlacedCorner.Corner = Position;
+            PlacedCorner.CornerMesh = Mesh;
+            PlacedCorner.Transform = FTransform(Rotations[Slot], FinalPosition, FVector:: OneVector);
+            PlacedCorner.GridVertex = Corner.Vertex;
+            PlacedCorner.bInnerCorner = bInner;
+
+            UE_LOG(LogTemp, Verbose, TEXT("  Placed %s %s corner at position %s"),
+            bInner ? TEXT("inner") : TEXT("outer"), *UEnum::GetValueAsString(Position), *FinalPosition.ToString());
+        }
 
-        // Create placed corner info
-        FPlacedCornerInfo PlacedCorner;
-        PlacedCorner.Corner = CornerData. Position;
-        PlacedCorner.CornerMesh = WallData->DefaultCornerMesh;
-        PlacedCorner.Transform = CornerTransform;
+        const int32 NumCorners = PlacedCornerMeshes.Num() - FirstCorner;
+        if (NumCorners == 0) continue;
 
-        PlacedCornerMeshes.Add(PlacedCorner);
+        // One mesh for both kinds: a single batch
+        if (CornerMeshBatches.Num() > 0 && CornerMeshBatches.Last().CornerMesh == Mesh) { CornerMeshBatches.Last().NumCorners += NumCorners; continue; }
 
-        UE_LOG(LogTemp, Verbose, TEXT("  Placed %s corner at position %s with rotation (%.0f, %.0f, %.0f)"),
-        *CornerData.Name,  *FinalPosition.ToString(), CornerData. Rotation.Roll, CornerData.Rotation. Pitch, CornerData.Rotation.Yaw);
+        FCornerMeshBatch& Batch = CornerMeshBatches.AddDefaulted_GetRef();
+        Batch.CornerMesh = Mesh;
+        Batch.FirstCorner = FirstCorner;
+        Batch.NumCorners = NumCorners;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCorners - Complete.  Placed %d corners"), PlacedCornerMeshes.Num());
+    UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCorners - Complete.  Placed %d corners in %d mesh batch(es)"),
+        PlacedCornerMeshes.Num(), CornerMeshBatches.Num());
 
     return true;
 }
 void URoomGenerator::ClearPlacedCorners()
 {
 	PlacedCornerMeshes.Empty();
+	CornerMeshBatches.Empty();
 }
 #pragma endregion
 
@@ -1137,6 +1252,8 @@ FPlacedDoorwayInfo URoomGenerator::CalculateDoorwayTransforms(const FDoorwayLayo
 
 void URoomGenerator::MarkDoorwayCells()
 {
+    // Doorway cells usually sit outside the grid; gather the ones inside and write them as one batch
+    TArray<FIntPoint> DoorwayCells;
     for (const FPlacedDoorwayInfo& Doorway : PlacedDoorwayMeshes)
     {
         TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Doorway.Edge, GridSize);
@@ -1151,19 +1268,72 @@ void URoomGenerator::MarkDoorwayCells()
                 // Mark in grid state (if cell is within interior grid)
                 // Note:  Boundary cells (virtual) are outside interior grid bounds
                 // So we only mark if cell is within (0, GridSize-1)
-                if (Cell.X >= 0 && Cell.X < GridSize. X && Cell.Y >= 0 && Cell.Y < GridSize.Y)
+                if (IsValidGridCoordinate(Cell))
                 {
-                    int32 GridIndex = Cell.Y * GridSize.X + Cell.X;
-                    if (GridState. IsValidIndex(GridIndex))
-                    {
-                        GridState[GridIndex] = EGridCellType::ECT_Doorway;
-                    }
+                    DoorwayCells.Add(Cell);
                 }
                 
                 UE_LOG(LogTemp, VeryVerbose, TEXT("    Marked doorway cell:  (%d, %d)"), Cell.X, Cell.Y);
             }
         }
     }
+
+    // Only open a journal section when something is written (an empty one would block the floor rollback)
+    if (DoorwayCells.Num() > 0)
+    {
+        ChangeJournal.BeginPhase(EGridPhase::Doorways, PlacedFloorMeshes.Num());
+        WriteCellList(DoorwayCells, EGridCellType::ECT_Doorway);
+    }
+
+    PublishSnapshot();
+    ValidateReachability();
+}
+
+void URoomGenerator::GetDoorwayEntryCells(TArray<FIntPoint>& OutCells) const
+{
+	for (const FPlacedDoorwayInfo& Doorway : PlacedDoorwayMeshes)
+	{
+		const TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Doorway.Edge, GridSize);
+		for (int32 i = 0; i < Doorway.WidthInCells; ++i)
+		{
+			const int32 CellIndex = Doorway.StartCell + i;
+			if (CellIndex < 0 || CellIndex >= EdgeCells.Num()) continue;
+
+			// Edge cells sit one step outside the grid; clamp back onto the interior cell they open into
+			const FIntPoint& Cell = EdgeCells[CellIndex];
+			OutCells.Add(FIntPoint(FMath::Clamp(Cell.X, 0, GridSize.X - 1), FMath::Clamp(Cell.Y, 0, GridSize.Y - 1)));
+		}
+	}
+}
+
+int32 URoomGenerator::ValidateReachability()
+{
+	if (!CellTypeBoard.IsInitialized())
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::ValidateReachability - Cell type board not built")); return 0; }
+
+	Connectivity.Build(CellTypeBoard, GridWalkable::Planes);
+
+	TArray<FIntPoint> Seeds;
+	GetDoorwayEntryCells(Seeds);
+	const int32 NumReachable = Connectivity.FloodFrom(Seeds);
+	const int32 NumComponents = Connectivity.GetNumComponents();
+
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ValidateReachability - %d walkable cells in %d component(s), %d reachable from %d doorway cell(s)"),
+		Connectivity.GetNumWalkableCells(), NumComponents, NumReachable, Seeds.Num());
+
+	if (Seeds.Num() == 0) return 0;
+
+	int32 NumUnreachable = 0;
+	for (int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		if (Connectivity.IsComponentReached(Component)) continue;
+
+		const FIntPoint Anchor = Connectivity.GetComponentAnchor(Component);
+		UE_LOG(LogTemp, Warning, TEXT("  Unreachable region: %d cells starting at (%d, %d)"),
+			Connectivity.GetComponentSize(Component), Anchor.X, Anchor.Y);
+		NumUnreachable += Connectivity.GetComponentSize(Component);
+	}
+	return NumUnreachable;
 }
 
 bool URoomGenerator::IsCellPartOfDoorway(FIntPoint Cell) const
@@ -1215,140 +1385,71 @@ bool URoomGenerator::GenerateCeiling()
 
 	if (CeilingData->CeilingTilePool.Num() == 0)
 	{ UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCeiling - No tiles in CeilingTilePool! ")); return false; }
+
+	if (!CellTypeBoard.IsInitialized())
+	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCeiling - Grid not created! ")); return false; }
 	
     // Clear previous ceiling data
     ClearPlacedCeiling();
 
     UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCeiling - Starting ceiling generation"));
 
-    // Create occupancy grid
-    TArray<bool> CeilingOccupied;
-    CeilingOccupied.Init(false, GridSize.X * GridSize.Y);
-
-    FRandomStream Stream(FMath::  Rand());
+    // Occupancy lives in the grid's ceiling layer (set = occupied), tiled by the same placement engine as the floor
+    const int32 UncoveredCells = SeedCeilingCoverage(CeilingData->CoverageMode);
+    if (UncoveredCells > 0)
+    { UE_LOG(LogTemp, Log, TEXT("  Coverage: %d cells outside the floor mask left open"), UncoveredCells); }
+    FCeilingPlacementEngine Engine = MakeCeilingPlacementEngine();
 
     int32 CeilingLargeTilesPlaced = 0;
     int32 CeilingMediumTilesPlaced = 0;
     int32 CeilingSmallTilesPlaced = 0;
 	int32 CeilingFillerTilesPlaced = 0; 
-     
-    // HELPER LAMBDAS
-     
-
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
 
 	// PHASE 0:  FORCED PLACEMENTS (Designer overrides - highest priority)
-	int32 ForcedCount = ExecuteForcedCeilingPlacements(CeilingOccupied);
+	int32 ForcedCount = ExecuteForcedCeilingPlacements(Engine);
 	if (ForcedCount > 0)
 	{ UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced ceiling tiles"), ForcedCount); }
-	
-    // PASS 1:  LARGE TILES (4x4)
-	// Large tiles (400x400, 200x400, 400x200)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(4, 4), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 4), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(4, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
-
-	// Medium tiles (200x200)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingMediumTilesPlaced);
-
-	// Small tiles (100x200, 200x100, 100x100)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(1, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 1), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(1, 1), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
 
+	const TArray<FMeshPlacementInfo>& CeilingTiles = CeilingData->CeilingTilePool;
+	if (CeilingData->CoverageMode == ECeilingCoverageMode::MirrorFloor)
+	{
+		// PHASE 0.5: MIRROR FLOOR (one ceiling tile over each floor tile with a matching footprint)
+		int32 MirroredCount = MirrorFloorLayout(Engine, CeilingTiles,
+			CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Mirrored %d/%d floor tiles"), MirroredCount, PlacedFloorMeshes.Num());
+	}
 
-     
-    // PASS 2:  MEDIUM TILES (2x2)
-	int32 GapFillCount = FillRemainingCeilingGaps(CeilingData->CeilingTilePool, CeilingOccupied, CeilingData->CeilingRotation, CeilingData->CeilingHeight,
-	  CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
-	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Filled %d remaining gaps"), GapFillCount);
-     
-    // PASS 3:  SMALL TILES (1x1)
-	if (CeilingData->CeilingTilePool.Num() > 0)
-    {
-        for (int32 Y = 0; Y < GridSize.Y; Y++)
-        {
-            for (int32 X = 0; X < GridSize.X; X++)
-            {
-                if (!  IsCellOccupied(X, Y))
-                {
-                	FMeshPlacementInfo SelectedTile = SelectWeightedMesh(CeilingData->CeilingTilePool);
+	if (CeilingData->TilingMode == EFloorTilingMode::Hierarchical)
+	{
+		// PHASE 1: HIERARCHICAL FILL (4x4 blocks subdivided down to 1x1 in a single pass)
+		int32 HierarchicalCount = Engine.FillHierarchical(CeilingTiles,
+			CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 1: Placed %d tiles"), HierarchicalCount);
+	}
+	else
+	{
+		// PHASE 1: GREEDY FILL (Large → Medium → Small)
+		Engine.FillLadder(CeilingTiles, FRoomPlacement::GreedyLadder,
+			CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
+
+		// PHASE 2: GAP FILL
+		int32 GapFillCount = Engine.FillLadder(CeilingTiles, FRoomPlacement::GapLadder,
+			CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Filled %d remaining gaps"), GapFillCount);
+	}
 
-                    if (SelectedTile.MeshAsset.IsNull())
-                    {
-                        // ✅ CHANGED:   Use GridFootprint from tile
-                        FIntPoint TileFootprint = SelectedTile.GridFootprint;
-                        
-                        FVector TilePosition = FVector(
-                            (X + TileFootprint.X / 2.0f) * CellSize,
-                            (Y + TileFootprint.Y / 2.0f) * CellSize,
-                            CeilingData->CeilingHeight
-                        );
-
-                    	// Create rotation (base ceiling rotation + tile rotation)
-                    	FRotator FinalRotation = CeilingData->CeilingRotation;
-
-                    	// Normalize quaternion to avoid floating point errors
-                    	FQuat NormalizedRotation = FinalRotation.Quaternion();
-                    	NormalizedRotation.Normalize();
-
-                    	// Create transform
-                    	FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-                        FPlacedCeilingInfo PlacedTile;
-                        PlacedTile. GridCoordinate = FIntPoint(X, Y);
-                        PlacedTile.TileSize = TileFootprint;
-                        PlacedTile.MeshInfo = SelectedTile;
-                         PlacedTile.LocalTransform = TileTransform;
-
-                        PlacedCeilingTiles.Add(PlacedTile);
-                        MarkCellsOccupied(X, Y, TileFootprint);
-                        CeilingSmallTilesPlaced++;
-                    }
-                }
-            }
-        }
-    }
+	// Cross-layer check: placed floor cells the ceiling layer left open (one AND-NOT word pass)
+	const int32 OpenAboveFloor = CellTypeBoard.CountCombined(FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh),
+		FGridBitboard::PlaneOf(EGridLayer::Ceiling), EGridPlaneOp::AndNot);
+	if (OpenAboveFloor > 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("  %d floor cells have no ceiling tile above them"), OpenAboveFloor); }
 
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCeiling - Complete:  %d large, %d medium, %d small, %d filler = %d total"),
 		CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced, PlacedCeilingTiles. Num());
 
 	return true;
 }
-int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied)
+int32 URoomGenerator::ExecuteForcedCeilingPlacements(FCeilingPlacementEngine& Engine)
 {
     if (!bIsInitialized || ! RoomData)
     {
@@ -1368,59 +1469,11 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
 
     int32 SuccessfulPlacements = 0;
 
-    // Load ceiling data for height/rotation
-    CeilingData = RoomData->CeilingStyleData.LoadSynchronous();
-    if (!CeilingData)
+    // Process each forced placement
+    for (int32 i = 0; i < RoomData->ForcedCeilingPlacements. Num(); ++i)
     {
-        UE_LOG(LogTemp, Error, TEXT("ExecuteForcedCeilingPlacements - Failed to load CeilingStyleData"));
-        return 0;
-    }
-
-    // Lambda: Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 CheckX = StartX + dx;
-                int32 CheckY = StartY + dy;
-                
-                if (CheckX < 0 || CheckX >= GridSize.X || CheckY < 0 || CheckY >= GridSize.Y)
-                    return false;
-
-                int32 Index = CheckY * GridSize.X + CheckX;
-                if (CeilingOccupied. IsValidIndex(Index) && CeilingOccupied[Index])
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                int32 Index = Y * GridSize.X + X;
-
-                if (CeilingOccupied.IsValidIndex(Index))
-                {
-                    CeilingOccupied[Index] = true;
-                }
-            }
-        }
-    };
-
-    // Process each forced placement
-    for (int32 i = 0; i < RoomData->ForcedCeilingPlacements. Num(); ++i)
-    {
-        const FForcedCeilingPlacement& ForcedTile = RoomData->ForcedCeilingPlacements[i];
-        const FMeshPlacementInfo& TileInfo = ForcedTile. TileInfo;  // ✅ Now uses FMeshPlacementInfo
+        const FForcedCeilingPlacement& ForcedTile = RoomData->ForcedCeilingPlacements[i];
+        const FMeshPlacementInfo& TileInfo = ForcedTile. TileInfo;
 
         UE_LOG(LogTemp, Verbose, TEXT("  Forced Tile [%d]:  Coord=(%d,%d), Footprint=(%d,%d)"),
             i, ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y,
@@ -1433,89 +1486,21 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
             continue;
         }
 
-        // Calculate original footprint
-        FIntPoint OriginalFootprint = CalculateFootprint(TileInfo);
+        // Forced placement overrides, else the tile's default rotations (0° if neither lists any)
+        const TArray<int32>& RotationsToTry = ForcedTile.AllowedRotations.Num() > 0 ? ForcedTile.AllowedRotations : TileInfo.AllowedRotations;
 
-        // Try to find a rotation that fits
-        int32 BestRotation = -1;
-        FIntPoint BestFootprint;
-
-        // Determine rotations to try
-        TArray<int32> RotationsToTry;
-        if (ForcedTile.AllowedRotations.Num() > 0)
-        {
-            RotationsToTry = ForcedTile.AllowedRotations;  // Use forced placement overrides
-        }
-        else if (TileInfo.AllowedRotations.Num() > 0)
-        {
-            RotationsToTry = TileInfo.AllowedRotations;    // Use tile's default rotations
-        }
-        else
-        {
-            RotationsToTry. Add(0);  // Default to no rotation
-        }
-
-        // Try each allowed rotation
-        for (int32 Rotation : RotationsToTry)
-        {
-            FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-            // Check bounds
-            int32 EndX = ForcedTile.GridCoordinate.X + RotatedFootprint.X;
-            int32 EndY = ForcedTile.GridCoordinate.Y + RotatedFootprint.Y;
-
-            if (EndX <= GridSize.X && EndY <= GridSize.Y &&
-                ForcedTile.GridCoordinate.X >= 0 && ForcedTile.GridCoordinate.Y >= 0)
-            {
-                // Check availability
-                if (IsAreaAvailable(ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y, RotatedFootprint))
-                {
-                    BestRotation = Rotation;
-                    BestFootprint = RotatedFootprint;
-                    break; // Use first valid rotation
-                }
-            }
-        }
-
-        // Check if we found a valid rotation
-        if (BestRotation == -1)
+        FIntPoint PlacedFootprint;
+        const int32 PlacedRotation = Engine.TryPlaceForced(ForcedTile.GridCoordinate, TileInfo, RotationsToTry, PlacedFootprint);
+        if (PlacedRotation == INDEX_NONE)
         {
             UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  No valid rotation fits (tried %d rotations)"),
-                RotationsToTry. Num());
+                FMath::Max(RotationsToTry.Num(), 1));
             continue;
         }
 
-        // Calculate tile position (centered on footprint)
-        FVector TilePosition = FVector(
-            (ForcedTile.GridCoordinate.X + BestFootprint.X / 2.0f) * CellSize,
-            (ForcedTile.GridCoordinate.Y + BestFootprint. Y / 2.0f) * CellSize,
-            CeilingData->CeilingHeight
-        );
-
-        // Create rotation (base ceiling rotation + tile rotation)
-        FRotator FinalRotation = CeilingData->CeilingRotation;
-        FinalRotation.Yaw += BestRotation;
-
-        // Normalize quaternion to avoid floating point errors
-        FQuat NormalizedRotation = FinalRotation.Quaternion();
-        NormalizedRotation.Normalize();
-
-        // Create transform
-        FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-        // Create placed ceiling info
-        FPlacedCeilingInfo PlacedTile;
-        PlacedTile.GridCoordinate = ForcedTile.GridCoordinate;
-        PlacedTile.TileSize = BestFootprint;
-        PlacedTile.MeshInfo = TileInfo;  // ✅ Store full MeshPlacementInfo
-         PlacedTile.LocalTransform = TileTransform;
-
-        PlacedCeilingTiles.Add(PlacedTile);
-        MarkCellsOccupied(ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y, BestFootprint);
-
         UE_LOG(LogTemp, Log, TEXT("    ✓ Placed forced tile at (%d,%d) size (%dx%d) rotation (%d°)"),
             ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y,
-            BestFootprint.X, BestFootprint.Y, BestRotation);
+            PlacedFootprint.X, PlacedFootprint.Y, PlacedRotation);
 
         SuccessfulPlacements++;
     }
@@ -1525,441 +1510,148 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
 
     return SuccessfulPlacements;
 }
-#pragma endregion
 
-#pragma region Internal Floor Generation
-void URoomGenerator::FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, 
-	FIntPoint TargetSize,
-	int32& OutLargeTiles,
-	int32& OutMediumTiles,
-	int32& OutSmallTiles,
-	int32& OutFillerTiles)
+int32 URoomGenerator::SeedCeilingCoverage(ECeilingCoverageMode Mode)
 {
-	// Filter tiles that match target size
-	TArray<FMeshPlacementInfo> MatchingTiles;
+	// Only the ceiling layer is rewritten; floor planes and the other layers keep their bits
+	const int32 CeilingPlane = FGridBitboard::PlaneOf(EGridLayer::Ceiling);
+	CellTypeBoard.FillPlane(CeilingPlane, false);
+	if (Mode == ECeilingCoverageMode::FullGrid) return 0;
+
+	// Floor mask: placed floor tiles, doorway cells and cells still open for floor placement (forced empty, void
+	// and off-shape cells fall outside it); everything else starts occupied so no tile is placed there
+	const int32 FloorPlanes[] = {
+		FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh),
+		FGridBitboard::PlaneOf(EGridCellType::ECT_Doorway),
+		FGridBitboard::PlaneOf(FloorTargetCellType)
+	};
+	return CellTypeBoard.CopyPlaneUnion(CeilingPlane, CellTypeBoard, FloorPlanes, true);
+}
 
-	for (const FMeshPlacementInfo& MeshInfo : TilePool)
+int32 URoomGenerator::MirrorFloorLayout(FCeilingPlacementEngine& Engine, const TArray<FMeshPlacementInfo>& TilePool,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+{
+	// Matching ceiling tiles gathered once per floor footprint
+	TMap<FIntPoint, TArray<FMeshPlacementInfo>> TilesByFootprint;
+	int32 MirroredCount = 0;
+	for (const FPlacedMeshInfo& FloorMesh : PlacedFloorMeshes)
 	{
-		FIntPoint Footprint = CalculateFootprint(MeshInfo);
+		TArray<FMeshPlacementInfo>* MatchingTiles = TilesByFootprint.Find(FloorMesh.GridFootprint);
+		if (!MatchingTiles)
+		{
+			MatchingTiles = &TilesByFootprint.Add(FloorMesh.GridFootprint);
+			FRoomPlacement::GatherTilesForFootprint(TilePool, FloorMesh.GridFootprint, *MatchingTiles);
+		}
 
-		// Check if footprint matches target size (or rotated version)
-		if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
-			(Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
+		// Footprints without a ceiling tile are left to the regular fill
+		if (Engine.TryPlaceWeighted(*MatchingTiles, FloorMesh.GridPosition, FloorMesh.GridFootprint))
 		{
-			MatchingTiles.Add(MeshInfo);
+			FRoomPlacement::CountPlacedTile(FloorMesh.GridFootprint, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+			MirroredCount++;
 		}
 	}
+	return MirroredCount;
+}
 
-	if (MatchingTiles.Num() == 0) return; // No tiles of this size
+FPlacedCeilingInfo URoomGenerator::MakePlacedCeilingTile(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation) const
+{
+	// Calculate tile position (centered on footprint)
+	const FVector TilePosition((StartCoord.X + Size.X / 2.0f) * CellSize, (StartCoord.Y + Size.Y / 2.0f) * CellSize, CeilingData->CeilingHeight);
+
+	// Base ceiling rotation + tile rotation (quaternion normalized to avoid floating point errors)
+	FRotator FinalRotation = CeilingData->CeilingRotation;
+	FinalRotation.Yaw += Rotation;
+	FQuat NormalizedRotation = FinalRotation.Quaternion();
+	NormalizedRotation.Normalize();
+
+	FPlacedCeilingInfo PlacedTile;
+	PlacedTile.GridCoordinate = StartCoord;
+	PlacedTile.TileSize = Size;
+	PlacedTile.Rotation = Rotation;
+	PlacedTile.MeshInfo = MeshInfo;
+	PlacedTile.LocalTransform = FTransform(NormalizedRotation, TilePosition, FVector(1.0f));
+	return PlacedTile;
+}
 
-	UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator::FillWithTileSize - Filling with %dx%d tiles (%d options)"), 
-		TargetSize.X, TargetSize.Y, MatchingTiles.Num());
+FCeilingPlacementEngine URoomGenerator::MakeCeilingPlacementEngine()
+{
+	return FCeilingPlacementEngine(FBitboardPlacementLayer(CellTypeBoard, FGridBitboard::PlaneOf(EGridLayer::Ceiling)), PlacedCeilingTiles,
+		[this](FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+		{ return MakePlacedCeilingTile(StartCoord, Size, MeshInfo, Rotation); });
+}
+#pragma endregion
 
-	// Try to place tiles of this size across the grid
-	for (int32 Y = 0; Y < GridSize.Y; ++Y)
-	{
-		for (int32 X = 0; X < GridSize.X; ++X)
-		{
-			FIntPoint StartCoord(X, Y);
+#pragma region Internal Floor Generation
+void URoomGenerator::FillFloorGreedy(const TArray<FMeshPlacementInfo>& TilePool,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+{
+	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), TilePool.Num());
 
-			// Check if area is available for target size
-			if (IsAreaAvailable(StartCoord, TargetSize))
-			{
-				// Select weighted random mesh
-				FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-				FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-				// Find rotation that matches target size
-				int32 BestRotation = 0;
-				
-				if (SelectedMesh.AllowedRotations.Num() > 0)
-				{
-					// Build list of rotations that would fit the target size
-					TArray<int32> ValidRotations;
-
-					for (int32 Rotation :  SelectedMesh.AllowedRotations)
-					{
-						FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-						
-						if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-						{
-							ValidRotations.Add(Rotation);
-						}
-					}
-
-					// Select random rotation from valid options
-					if (ValidRotations.Num() > 0)
-					{
-						int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-						BestRotation = ValidRotations[RandomIndex];
-					}
-				}
+	// Large (4x4, 2x4, 4x2) → Medium (2x2) → Small (1x2, 2x1, 1x1), one full-grid pass each
+	FFloorPlacementEngine Engine = MakeFloorPlacementEngine();
+	Engine.FillLadder(TilePool, FRoomPlacement::GreedyLadder, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
 
-				// Try to place mesh with selected rotation
-				if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-				{
-					// Update statistics
-					int32 TileArea = TargetSize.X * TargetSize.Y;
-					if (TileArea >= 16) OutLargeTiles++;
-					else if (TileArea >= 4) OutMediumTiles++;
-					else if (TileArea >= 2) OutSmallTiles++;
-					else OutFillerTiles++;
-				}
-			}
-		}
-	}
+	// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
+	int32 GapFillCount = FillRemainingGaps(TilePool, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+	UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
 }
 
-FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool)
+int32 URoomGenerator::FillFloorHierarchical(const TArray<FMeshPlacementInfo>& TilePool,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
 {
-	// Delegate to helper function
-	const FMeshPlacementInfo* Selected = URoomGenerationHelpers::SelectWeightedMeshPlacement(Pool);
-	
-	// Return by value (copy), or empty if selection failed
-	if (Selected) return *Selected;
-	
-	return FMeshPlacementInfo(); // Return empty if pool was empty
+	FFloorPlacementEngine Engine = MakeFloorPlacementEngine();
+	const int32 PlacedCount = Engine.FillHierarchical(TilePool, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+	if (PlacedCount == 0 && GetCellCountByType(FloorTargetCellType) > 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::FillFloorHierarchical - No tiles placed (does the pool match the footprint ladder?)")); }
+	return PlacedCount;
 }
 
-bool URoomGenerator::TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+FPlacedMeshInfo URoomGenerator::MakePlacedFloorMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation) const
 {
-	if (! URoomGenerationHelpers::TryPlaceMeshInGrid(GridState, GridSize, StartCoord, Size, 
-	   FloorTargetCellType,EGridCellType::ECT_FloorMesh))
-	   	return false;
-	
-	// Create placed mesh info
 	FPlacedMeshInfo PlacedMesh;
 	PlacedMesh.GridPosition = StartCoord;
 	PlacedMesh.GridFootprint = Size;
-	PlacedMesh. Rotation = Rotation;
+	PlacedMesh.Rotation = Rotation;
 	PlacedMesh.MeshInfo = MeshInfo;
 
 	// Calculate transform using helper
-	PlacedMesh.LocalTransform = URoomGenerationHelpers::CalculateMeshTransform(StartCoord,Size,
-	CellSize, Rotation,0.0f);  // Z offset (floor is at 0)
-
-	// Store placed mesh (internal state management)
-	PlacedFloorMeshes.Add(PlacedMesh);
-
-	return true;
+	PlacedMesh.LocalTransform = URoomGenerationHelpers::CalculateMeshTransform(StartCoord, Size,
+	CellSize, Rotation, 0.0f);  // Z offset (floor is at 0)
+	return PlacedMesh;
 }
 
-FIntPoint URoomGenerator::CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const
+FFloorPlacementEngine URoomGenerator::MakeFloorPlacementEngine()
 {
-	// If footprint is explicitly defined, use it
-	if (MeshInfo.GridFootprint.X > 0 && MeshInfo. GridFootprint.Y > 0) return MeshInfo.GridFootprint;
-
-	// Otherwise, calculate from mesh bounds
-	if (! MeshInfo.MeshAsset. IsNull())
-	{
-		// For now, return default 1x1 if bounds not available
-		// TODO: Load mesh and calculate actual bounds
-		return FIntPoint(1, 1);
-	}
-
-	// Fallback
-	return FIntPoint(1, 1);
+	return FFloorPlacementEngine(FFloorPlacementLayer(*this, FloorTargetCellType, EGridCellType::ECT_FloorMesh), PlacedFloorMeshes,
+		[this](FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+		{ return MakePlacedFloorMesh(StartCoord, Size, MeshInfo, Rotation); });
 }
 
-void URoomGenerator::FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied,
-	FIntPoint TargetSize, const FRotator& CeilingRotation, float CeilingHeight, int32& OutTilesPlaced)
+FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool)
 {
-	// Filter tiles that match target size
-    TArray<FMeshPlacementInfo> MatchingTiles;
-
-    for (const FMeshPlacementInfo& TileInfo :  TilePool)
-    {
-        FIntPoint Footprint = CalculateFootprint(TileInfo);
-
-        // Check if footprint matches target size (or rotated version)
-        if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize. Y) ||
-            (Footprint.X == TargetSize.Y && Footprint.Y == TargetSize.X))
-        {
-            MatchingTiles.Add(TileInfo);
-        }
-    }
-
-    if (MatchingTiles. Num() == 0) return; // No tiles of this size
-
-    UE_LOG(LogTemp, Verbose, TEXT("  Filling ceiling with %dx%d tiles (%d options)"),
-        TargetSize.X, TargetSize. Y, MatchingTiles. Num());
-
-    // Lambda:  Check if cell is occupied
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    // Lambda: Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    // Try to place tiles of this size across the grid
-    for (int32 Y = 0; Y < GridSize.Y; ++Y)
-    {
-        for (int32 X = 0; X < GridSize.X; ++X)
-        {
-            // Check if area is available for target size
-            if (IsAreaAvailable(X, Y, TargetSize))
-            {
-                // Select weighted random mesh
-                FMeshPlacementInfo SelectedTile = SelectWeightedMesh(MatchingTiles);
-                FIntPoint OriginalFootprint = CalculateFootprint(SelectedTile);
-
-                // Find rotation that matches target size
-                int32 BestRotation = 0;
-
-                if (SelectedTile.AllowedRotations.Num() > 0)
-                {
-                    // Build list of rotations that would fit the target size
-                    TArray<int32> ValidRotations;
-
-                    for (int32 Rotation : SelectedTile.AllowedRotations)
-                    {
-                        FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-                        if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-                        {
-                            ValidRotations.Add(Rotation);
-                        }
-                    }
-
-                    // Select random rotation from valid options
-                    if (ValidRotations.Num() > 0)
-                    {
-                        int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-                        BestRotation = ValidRotations[RandomIndex];
-                    }
-                }
-            	           	
-                // Calculate tile position (centered on footprint)
-                FVector TilePosition = FVector(
-                    (X + TargetSize.X / 2.0f) * CellSize,
-                    (Y + TargetSize.Y / 2.0f) * CellSize,
-                    CeilingHeight
-                );
-
-                // Create rotation (base ceiling rotation + tile rotation)
-                FRotator FinalRotation = CeilingRotation;
-                FinalRotation. Yaw += BestRotation;
-            	
-                // Create transform
-                FTransform TileTransform(FinalRotation, TilePosition, FVector(1.0f));
-
-                // Create placed ceiling info
-                FPlacedCeilingInfo PlacedTile;
-                PlacedTile. GridCoordinate = FIntPoint(X, Y);
-                PlacedTile.TileSize = TargetSize;
-                PlacedTile.MeshInfo = SelectedTile;  // ✅ Store full MeshPlacementInfo
-                 PlacedTile.LocalTransform = TileTransform;
-
-                PlacedCeilingTiles.Add(PlacedTile);
-                MarkCellsOccupied(X, Y, TargetSize);
-                OutTilesPlaced++;
-            }
-        }
-    }
+	// Delegate to helper function
+	const FMeshPlacementInfo* Selected = URoomGenerationHelpers::SelectWeightedMeshPlacement(Pool);
+	
+	// Return by value (copy), or empty if selection failed
+	if (Selected) return *Selected;
+	
+	return FMeshPlacementInfo(); // Return empty if pool was empty
 }
 
-int32 URoomGenerator::FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool,
-	TArray<bool>& CeilingOccupied, const FRotator& CeilingRotation, float CeilingHeight, int32& OutLargeTiles,
-	int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+bool URoomGenerator::TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
 {
-	 if (TilePool.Num() == 0)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("  FillRemainingCeilingGaps - No tiles in pool!"));
-        return 0;
-    }
-
-    int32 PlacedCount = 0;
+	if (!IsAreaAvailable(StartCoord, Size)) return false;
+	WriteCells(StartCoord, Size, EGridCellType::ECT_FloorMesh);
 
-    // Define sizes to try (largest to smallest for efficiency)
-    TArray<FIntPoint> SizesToTry = {
-        FIntPoint(1, 4), // 100x400
-        FIntPoint(4, 1), // 400x100
-        FIntPoint(1, 2), // 100x200
-        FIntPoint(2, 1), // 200x100
-        FIntPoint(1, 1)  // 100x100
-    };
-
-    UE_LOG(LogTemp, Verbose, TEXT("  FillRemainingCeilingGaps - Starting gap fill"));
-
-    // Lambda: Check if cell is occupied
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    // Lambda:  Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize. X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    // Try each size in order
-    for (const FIntPoint& TargetSize : SizesToTry)
-    {
-        // Filter tiles that match this size
-        TArray<FMeshPlacementInfo> MatchingTiles;
-
-        for (const FMeshPlacementInfo& TileInfo : TilePool)
-        {
-            FIntPoint Footprint = CalculateFootprint(TileInfo);
-
-            // Check if footprint matches target size (or rotated version)
-            if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
-                (Footprint.X == TargetSize.Y && Footprint.Y == TargetSize.X))
-            {
-                MatchingTiles.Add(TileInfo);
-            }
-        }
-
-        if (MatchingTiles.Num() == 0) continue; // No tiles of this size, try next
-
-        int32 SizePlacedCount = 0;
-
-        // Try to place tiles of this size in all empty spaces
-        for (int32 Y = 0; Y < GridSize.Y; ++Y)
-        {
-            for (int32 X = 0; X < GridSize.X; ++X)
-            {
-                // Check if area is available
-                if (IsAreaAvailable(X, Y, TargetSize))
-                {
-                    // Select weighted random mesh
-                    FMeshPlacementInfo SelectedTile = SelectWeightedMesh(MatchingTiles);
-                    FIntPoint OriginalFootprint = CalculateFootprint(SelectedTile);
-
-                    // Find rotation that matches target size
-                    int32 BestRotation = 0;
-
-                    if (SelectedTile.AllowedRotations. Num() > 0)
-                    {
-                        // Build list of rotations that would fit the target size
-                        TArray<int32> ValidRotations;
-
-                        for (int32 Rotation : SelectedTile.AllowedRotations)
-                        {
-                            FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-                            if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-                            {
-                                ValidRotations.Add(Rotation);
-                            }
-                        }
-
-                        // Select random rotation from valid options
-                        if (ValidRotations.Num() > 0)
-                        {
-                            int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-                            BestRotation = ValidRotations[RandomIndex];
-                        }
-                    }
-
-                    // Calculate tile position
-                    FVector TilePosition = FVector(
-                        (X + TargetSize.X / 2.0f) * CellSize,
-                        (Y + TargetSize.Y / 2.0f) * CellSize,
-                        CeilingHeight
-                    );
-
-                    // Create rotation
-                    FRotator FinalRotation = CeilingRotation;
-                    FinalRotation. Yaw += BestRotation;
-
-                    // Normalize quaternion
-                    FQuat NormalizedRotation = FinalRotation. Quaternion();
-                    NormalizedRotation.Normalize();
-
-                    // Create transform
-                    FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-                    // Create placed ceiling info
-                    FPlacedCeilingInfo PlacedTile;
-                    PlacedTile.GridCoordinate = FIntPoint(X, Y);
-                    PlacedTile.TileSize = TargetSize;
-                    PlacedTile.MeshInfo = SelectedTile;  // ✅ Store full MeshPlacementInfo
-                     PlacedTile.LocalTransform = TileTransform;
-
-                    PlacedCeilingTiles. Add(PlacedTile);
-                    MarkCellsOccupied(X, Y, TargetSize);
-
-                    SizePlacedCount++;
-                    PlacedCount++;
-
-                    // Update statistics
-                    int32 TileArea = TargetSize.X * TargetSize.Y;
-                    if (TileArea >= 16) OutLargeTiles++;
-                    else if (TileArea >= 4) OutMediumTiles++;
-                    else if (TileArea >= 2) OutSmallTiles++;
-                    else OutFillerTiles++;
-                }
-            }
-        }
-
-        if (SizePlacedCount > 0)
-        {
-            UE_LOG(LogTemp, Verbose, TEXT("    Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize.X, TargetSize.Y);
-        }
-    }
+	// Store placed mesh (internal state management)
+	PlacedFloorMeshes.Add(MakePlacedFloorMesh(StartCoord, Size, MeshInfo, Rotation));
 
-    UE_LOG(LogTemp, Verbose, TEXT("  FillRemainingCeilingGaps - Placed %d gap-fill tiles"), PlacedCount);
+	return true;
+}
 
-    return PlacedCount;
+FIntPoint URoomGenerator::CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const
+{
+	return FRoomPlacement::GetFootprint(MeshInfo);
 }
 #pragma endregion
 
@@ -1999,9 +1691,19 @@ FIntPoint URoomGenerator::GetRotatedFootprint(FIntPoint OriginalFootprint, int32
 
 int32 URoomGenerator::GetCellCountByType(EGridCellType CellType) const
 {
-	int32 Count = 0;
-	for (const EGridCellType& Cell : GridState)
-	{ if (Cell == CellType) ++Count; } return Count;
+	if (!CellTypeBoard.IsInitialized()) return 0;
+
+	// Popcount over the cell type plane (64 cells per word)
+	return CellTypeBoard.CountSet(FGridBitboard::PlaneOf(CellType));
+}
+
+void URoomGenerator::GetCellTypeHistogram(TArray<int32>& OutCounts) const
+{
+	OutCounts.Reset();
+	OutCounts.SetNumZeroed(FGridBitboard::NumCellTypePlanes);
+	if (!CellTypeBoard.IsInitialized()) return;
+
+	for (int32 Plane = 0; Plane < FGridBitboard::NumCellTypePlanes; ++Plane) { OutCounts[Plane] = CellTypeBoard.CountSet(Plane); }
 }
 
 float URoomGenerator::GetOccupancyPercentage() const
@@ -2031,26 +1733,44 @@ FIntPoint URoomGenerator:: IndexToGridCoord(int32 Index) const
 }
 
 void URoomGenerator::FillWallEdge(EWallEdge Edge)
+{
+    // The bounding edge as an outline run of the full grid
+    FGridContourRun Run;
+    switch (Edge)
+    {
+    case EWallEdge::North:	Run.Side = ECellDirection::East;	Run.Lane = GridSize.X - 1;	Run.Length = GridSize.Y; break;
+    case EWallEdge::South:	Run.Side = ECellDirection::West;	Run.Lane = 0;				Run.Length = GridSize.Y; break;
+    case EWallEdge::East:	Run.Side = ECellDirection::North;	Run.Lane = GridSize.Y - 1;	Run.Length = GridSize.X; break;
+    default:				Run.Side = ECellDirection::South;	Run.Lane = 0;				Run.Length = GridSize.X; break;
+    }
+    FillWallRun(Run);
+}
+
+void URoomGenerator::FillWallRun(const FGridContourRun& Run)
 {
     if (!  RoomData || RoomData->WallStyleData.IsNull()) return;
 
     WallData = RoomData->WallStyleData.LoadSynchronous();
     if (!WallData || WallData->AvailableWallModules. Num() == 0) return;
 
-    TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Edge, GridSize);
-    if (EdgeCells.Num() == 0) return;
+    if (Run.Length <= 0) return;
+
+    const EWallEdge Edge = URoomGenerationHelpers::GetWallEdgeForSide(Run.Side);
+    const int32 Line = Run.GetLine();
+    const int32 RunEnd = Run.First + Run.Length;
 
     FRotator WallRotation = URoomGenerationHelpers:: GetWallRotationForEdge(Edge);
-    UE_LOG(LogTemp, Verbose, TEXT("  Filling edge %s with %d cells"),
-        *UEnum::GetValueAsString(Edge), EdgeCells.Num());
+    UE_LOG(LogTemp, Verbose, TEXT("  Filling edge %s line %d with %d cells from %d"),
+        *UEnum::GetValueAsString(Edge), Line, Run.Length, Run.First);
 
     // Greedy bin packing: Fill with largest modules first (BASE LAYER ONLY)
-    int32 CurrentCell = 0;
+    // CurrentCell indexes along the edge like GetEdgeCellIndices, so forced walls and doorways line up
+    int32 CurrentCell = Run.First;
 
-    while (CurrentCell < EdgeCells. Num())
+    while (CurrentCell < RunEnd)
     {
         // ✅ FIXED:   Check if THIS SPECIFIC CELL is part of a doorway
-        FIntPoint CellToCheck = EdgeCells[CurrentCell];
+        FIntPoint CellToCheck = Run.GetOutsideCell(CurrentCell - Run.First);
         
         if (IsCellPartOfDoorway(CellToCheck))
         {
@@ -2061,7 +1781,7 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
         }
         
         // Skip cells occupied by forced walls
-        if (IsCellRangeOccupied(Edge, CurrentCell, 1))
+        if (IsCellRangeOccupied(Edge, Line, CurrentCell, 1))
         {
             UE_LOG(LogTemp, VeryVerbose, TEXT("    Skipping cell %d (occupied by forced wall)"), CurrentCell);
             CurrentCell++;
@@ -2070,7 +1790,7 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
         
         // Find largest module that fits remaining space
         const FWallModule* BestModule = nullptr;
-        int32 SpaceLeft = EdgeCells.Num() - CurrentCell;
+        int32 SpaceLeft = RunEnd - CurrentCell;
 
         for (const FWallModule& Module : WallData->AvailableWallModules)
         {
@@ -2080,9 +1800,9 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
             for (int32 i = 0; i < Module. Y_AxisFootprint; ++i)
             {
                 int32 CheckIndex = CurrentCell + i;
-                if (CheckIndex < EdgeCells.Num())
+                if (CheckIndex < RunEnd)
                 {
-                    FIntPoint CheckCell = EdgeCells[CheckIndex];
+                    FIntPoint CheckCell = Run.GetOutsideCell(CheckIndex - Run.First);
                     if (IsCellPartOfDoorway(CheckCell))
                     {
                         bModuleOverlapsDoorway = true;
@@ -2097,7 +1817,7 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
             }
             
             if (Module.Y_AxisFootprint <= SpaceLeft && 
-                !  IsCellRangeOccupied(Edge, CurrentCell, Module.Y_AxisFootprint))
+                !  IsCellRangeOccupied(Edge, Line, CurrentCell, Module.Y_AxisFootprint))
             {
                 if (!  BestModule || Module.Y_AxisFootprint > BestModule->Y_AxisFootprint)
                 {
@@ -2123,11 +1843,11 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
         }
 
         // Calculate position for this wall segment
-        FVector BasePosition = URoomGenerationHelpers:: CalculateWallPosition(
+        FVector BasePosition = URoomGenerationHelpers::CalculateWallPositionOnLine(
             Edge,
+            Line,
             CurrentCell,
             BestModule->Y_AxisFootprint,
-            GridSize,
             CellSize,
             WallData->NorthWallOffsetX,
             WallData->SouthWallOffsetX,
@@ -2141,6 +1861,7 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
         // Store segment info for Middle/Top spawning
         FGeneratorWallSegment Segment;
         Segment.Edge = Edge;
+        Segment.Line = Line;
         Segment. StartCell = CurrentCell;
         Segment. SegmentLength = BestModule->Y_AxisFootprint;
         Segment.BaseTransform = BaseTransform;
@@ -2157,3 +1878,172 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
     }
 }
 #pragma endregion
+
+#pragma region Benchmarks
+void URoomGenerator::BenchmarkFloorTilers(int32 MinSize, int32 MaxSize, int32 Step, int32 Iterations)
+{
+	if (!RoomData || !RoomData->FloorStyleData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::BenchmarkFloorTilers - FloorData not assigned!")); return; }
+
+	UFloorData* FloorStyleData = RoomData->FloorStyleData.LoadSynchronous();
+	if (!FloorStyleData || FloorStyleData->FloorTilePool.Num() == 0)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::BenchmarkFloorTilers - No floor meshes defined in FloorTilePool!")); return; }
+
+	MinSize = FMath::Max(MinSize, 1);
+	Step = FMath::Max(Step, 1);
+	Iterations = FMath::Max(Iterations, 1);
+
+	// Scratch generator so this room's grid and placements are untouched
+	URoomGenerator* Bench = NewObject<URoomGenerator>(this);
+	const TArray<FMeshPlacementInfo>& TilePool = FloorStyleData->FloorTilePool;
+
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::BenchmarkFloorTilers - %d iterations per size, fill phases only"), Iterations);
+	for (int32 Size = MinSize; Size <= MaxSize; Size += Step)
+	{
+		double TotalSeconds[2] = { 0.0, 0.0 };
+		int32 TotalMeshes[2] = { 0, 0 };
+		int32 TotalRemaining[2] = { 0, 0 };
+
+		for (int32 Mode = 0; Mode < 2; ++Mode)
+		{
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Bench->Initialize(RoomData, FIntPoint(Size, Size));
+				Bench->CreateGrid();
+				Bench->ClearPlacedFloorMeshes();
+
+				int32 Large = 0, Medium = 0, Small = 0, Filler = 0;
+				const double StartTime = FPlatformTime::Seconds();
+				if (Mode == 0) { Bench->FillFloorGreedy(TilePool, Large, Medium, Small, Filler); }
+				else { Bench->FillFloorHierarchical(TilePool, Large, Medium, Small, Filler); }
+				TotalSeconds[Mode] += FPlatformTime::Seconds() - StartTime;
+
+				TotalMeshes[Mode] += Bench->GetPlacedFloorMeshes().Num();
+				TotalRemaining[Mode] += Bench->GetCellCountByType(Bench->FloorTargetCellType);
+			}
+		}
+
+		const double GreedyMs = TotalSeconds[0] * 1000.0 / Iterations;
+		const double HierarchicalMs = TotalSeconds[1] * 1000.0 / Iterations;
+		UE_LOG(LogTemp, Log, TEXT("  %3dx%-3d  Greedy: %8.3f ms (%d meshes, %d empty)  Hierarchical: %8.3f ms (%d meshes, %d empty)  Speedup: %.2fx"),
+			Size, Size, GreedyMs, TotalMeshes[0] / Iterations, TotalRemaining[0] / Iterations,
+			HierarchicalMs, TotalMeshes[1] / Iterations, TotalRemaining[1] / Iterations,
+			HierarchicalMs > 0.0 ? GreedyMs / HierarchicalMs : 0.0);
+	}
+
+	Bench->ClearGrid();
+}
+
+void URoomGenerator::BenchmarkGridLayouts(int32 MinSize, int32 MaxSize, int32 Step, int32 Iterations)
+{
+	if (!RoomData || !RoomData->FloorStyleData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::BenchmarkGridLayouts - FloorData not assigned!")); return; }
+
+	UFloorData* FloorStyleData = RoomData->FloorStyleData.LoadSynchronous();
+	if (!FloorStyleData || FloorStyleData->FloorTilePool.Num() == 0)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::BenchmarkGridLayouts - No floor meshes defined in FloorTilePool!")); return; }
+
+	MinSize = FMath::Max(MinSize, 1);
+	Step = FMath::Max(Step, 1);
+	Iterations = FMath::Max(Iterations, 1);
+
+	const bool bHasCeiling = !RoomData->CeilingStyleData.IsNull();
+	const bool bHierarchical = FloorStyleData->TilingMode == EFloorTilingMode::Hierarchical;
+	const TArray<FMeshPlacementInfo>& TilePool = FloorStyleData->FloorTilePool;
+	const EGridMemoryLayout Layouts[] = { EGridMemoryLayout::RowMajor, EGridMemoryLayout::Tiled4x4, EGridMemoryLayout::Morton };
+
+	// Scratch generator so this room's grid and placements are untouched
+	URoomGenerator* Bench = NewObject<URoomGenerator>(this);
+
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::BenchmarkGridLayouts - %d iterations per size, %s floor tiling%s"),
+		Iterations, bHierarchical ? TEXT("hierarchical") : TEXT("greedy"), bHasCeiling ? TEXT("") : TEXT(", no ceiling data"));
+	for (int32 Size = MinSize; Size <= MaxSize; Size += Step)
+	{
+		for (EGridMemoryLayout Layout : Layouts)
+		{
+			double FloorSeconds = 0.0, CeilingSeconds = 0.0, TopologySeconds = 0.0;
+
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Bench->GridMemoryLayout = Layout;
+				Bench->Initialize(RoomData, FIntPoint(Size, Size));
+				Bench->CreateGrid();
+				Bench->ClearPlacedFloorMeshes();
+
+				int32 Large = 0, Medium = 0, Small = 0, Filler = 0;
+				double StartTime = FPlatformTime::Seconds();
+				if (bHierarchical) { Bench->FillFloorHierarchical(TilePool, Large, Medium, Small, Filler); }
+				else { Bench->FillFloorGreedy(TilePool, Large, Medium, Small, Filler); }
+				FloorSeconds += FPlatformTime::Seconds() - StartTime;
+
+				if (bHasCeiling)
+				{
+					StartTime = FPlatformTime::Seconds();
+					Bench->GenerateCeiling();
+					CeilingSeconds += FPlatformTime::Seconds() - StartTime;
+				}
+
+				StartTime = FPlatformTime::Seconds();
+				Bench->AnalyzeTopology();
+				TopologySeconds += FPlatformTime::Seconds() - StartTime;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("  %3dx%-3d  %-9s  Floor: %8.3f ms  Ceiling: %8.3f ms  Topology: %8.3f ms  (%d/%d chunks allocated)"),
+				Size, Size, *UEnum::GetDisplayValueAsText(Layout).ToString(),
+				FloorSeconds * 1000.0 / Iterations, CeilingSeconds * 1000.0 / Iterations, TopologySeconds * 1000.0 / Iterations,
+				Bench->CellChunks.GetNumAllocatedChunks(), Bench->CellChunks.GetNumChunks());
+		}
+	}
+
+	Bench->ClearGrid();
+}
+
+void URoomGenerator::BenchmarkParallelTopology(int32 MinSize, int32 MaxSize, int32 MaxBands, int32 Iterations)
+{
+	if (!RoomData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::BenchmarkParallelTopology - RoomData not assigned!")); return; }
+
+	MinSize = FMath::Max(MinSize, 1);
+	MaxBands = FMath::Max(MaxBands, 1);
+	Iterations = FMath::Max(Iterations, 1);
+
+	// Scratch generator so this room's grid and topology are untouched
+	URoomGenerator* Bench = NewObject<URoomGenerator>(this);
+
+	// Bands are spread over the whole task pool, so the axis is the band count; worker count stays fixed
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::BenchmarkParallelTopology - %d iterations, %d task workers (fixed), auto bands from %d cells"),
+		Iterations, FTaskGraphInterface::Get().GetNumWorkerThreads(), GridRowBands::MinParallelCells);
+	for (int32 Size = MinSize; Size <= MaxSize; Size *= 2)
+	{
+		// Floor with a lattice of forced-empty pillars so every band has boundary cells to classify
+		Bench->Initialize(RoomData, FIntPoint(Size, Size));
+		Bench->CreateGrid();
+		Bench->WriteCells(FIntPoint::ZeroValue, FIntPoint(Size, Size), EGridCellType::ECT_FloorMesh);
+		for (int32 Y = 3; Y < Size; Y += 8)
+		{
+			for (int32 X = 3; X < Size; X += 8) { Bench->WriteCells(FIntPoint(X, Y), FIntPoint(2, 2), EGridCellType::ECT_Empty); }
+		}
+		Bench->CellTopology.Init(Bench->GridSize);
+
+		double SerialTopology = 0.0;
+		for (int32 NumBands = 1; NumBands <= MaxBands; ++NumBands)
+		{
+			double TopologySeconds = 0.0;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Bench->CellTopology.AnalyzeAllRows(Bench->CellTypeBoard, NumBands);
+				Bench->CellTopology.BuildZoneIndex(NumBands);
+				TopologySeconds += FPlatformTime::Seconds() - StartTime;
+			}
+			TopologySeconds /= Iterations;
+			if (NumBands == 1) { SerialTopology = TopologySeconds; }
+
+			UE_LOG(LogTemp, Log, TEXT("  %4dx%-4d  %2d band(s)  Topology: %8.3f ms (x%.2f over one band)"),
+				Size, Size, NumBands, TopologySeconds * 1000.0, TopologySeconds > 0.0 ? SerialTopology / TopologySeconds : 0.0);
+		}
+	}
+
+	Bench->ClearGrid();
+}
+#pragma endregion
@@ -0,0 +1,138 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Rooms/RoomPlacementEngine.h"
+#include "Data/Grid/GridFootprintKernels.h"
+#include "Generators/Rooms/RoomGenerator.h"
+
+#pragma region Floor Placement Layer
+FFloorPlacementLayer::FFloorPlacementLayer(URoomGenerator& InGenerator, EGridCellType InFreeType, EGridCellType InMarkType)
+	: Generator(&InGenerator), FreePlane(FGridBitboard::PlaneOf(InFreeType)), MarkType(InMarkType)
+{
+}
+
+FIntPoint FFloorPlacementLayer::GetSize() const
+{
+	return Generator->GetGridSize();
+}
+
+bool FFloorPlacementLayer::IsAreaFree(FIntPoint Start, FIntPoint Size) const
+{
+	return Generator->IsAreaAvailable(Start, Size);
+}
+
+bool FFloorPlacementLayer::IsAreaFull(FIntPoint Start, FIntPoint Size) const
+{
+	return Generator->CellTypeBoard.IsRectClear(FreePlane, Start.X, Start.Y, Size.X, Size.Y);
+}
+
+void FFloorPlacementLayer::MarkArea(FIntPoint Start, FIntPoint Size)
+{
+	Generator->WriteCells(Start, Size, MarkType);
+}
+
+void FFloorPlacementLayer::BuildAnchorIndex(FGridAnchorIndex& OutIndex, FIntPoint Footprint) const
+{
+	OutIndex.Build(Generator->CellTypeBoard, FreePlane, true, Footprint);
+}
+#pragma endregion
+
+#pragma region Bitboard Placement Layer
+FBitboardPlacementLayer::FBitboardPlacementLayer(FGridBitboard& InBoard, int32 InPlane)
+	: Board(&InBoard), Plane(InPlane)
+{
+}
+
+bool FBitboardPlacementLayer::IsAreaFree(FIntPoint Start, FIntPoint Size) const
+{
+	if (Start.X < 0 || Start.Y < 0 || Size.X <= 0 || Size.Y <= 0) return false;
+	if (Start.X + Size.X > Board->GetWidth() || Start.Y + Size.Y > Board->GetHeight()) return false;
+
+	// Ladder footprints use the unrolled kernel, others a span mask test per row word
+	if (const FGridFootprintKernel* Kernel = FGridFootprintKernel::Find(Size)) return Kernel->IsClear(*Board, Plane, Start.X, Start.Y);
+	return Board->IsRectClear(Plane, Start.X, Start.Y, Size.X, Size.Y);
+}
+
+bool FBitboardPlacementLayer::IsAreaFull(FIntPoint Start, FIntPoint Size) const
+{
+	return Board->IsRectSet(Plane, Start.X, Start.Y, Size.X, Size.Y);
+}
+
+void FBitboardPlacementLayer::MarkArea(FIntPoint Start, FIntPoint Size)
+{
+	// Area was checked free, so every cell becomes newly blocked
+	if (const FGridFootprintKernel* Kernel = FGridFootprintKernel::Find(Size)) { Kernel->SetRect(*Board, Plane, Start.X, Start.Y, true); }
+	else { Board->SetRect(Plane, Start.X, Start.Y, Size.X, Size.Y, true); }
+}
+#pragma endregion
+
+#pragma region Placement Helpers
+const FIntPoint FRoomPlacement::GreedyLadder[7] = {
+	FIntPoint(4, 4), FIntPoint(2, 4), FIntPoint(4, 2),	// Large tiles (400x400, 200x400, 400x200)
+	FIntPoint(2, 2),									// Medium tiles (200x200)
+	FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(1, 1)	// Small tiles (100x200, 200x100, 100x100)
+};
+
+const FIntPoint FRoomPlacement::GapLadder[5] = {
+	FIntPoint(1, 4), FIntPoint(4, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(1, 1)
+};
+
+const FIntPoint FRoomPlacement::HierarchicalLadder[9] = {
+	FIntPoint(4, 4), FIntPoint(2, 4), FIntPoint(4, 2), FIntPoint(2, 2),
+	FIntPoint(1, 4), FIntPoint(4, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(1, 1)
+};
+
+FIntPoint FRoomPlacement::GetFootprint(const FMeshPlacementInfo& MeshInfo)
+{
+	// If footprint is explicitly defined, use it
+	if (MeshInfo.GridFootprint.X > 0 && MeshInfo.GridFootprint.Y > 0) return MeshInfo.GridFootprint;
+
+	// TODO: Load mesh and calculate actual bounds (1x1 until then)
+	return FIntPoint(1, 1);
+}
+
+void FRoomPlacement::GatherTilesForFootprint(const TArray<FMeshPlacementInfo>& TilePool, FIntPoint TargetSize,
+	TArray<FMeshPlacementInfo>& OutTiles)
+{
+	for (const FMeshPlacementInfo& MeshInfo : TilePool)
+	{
+		FIntPoint Footprint = GetFootprint(MeshInfo);
+
+		// Check if footprint matches target size (or rotated version)
+		if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
+			(Footprint.X == TargetSize.Y && Footprint.Y == TargetSize.X))
+		{
+			OutTiles.Add(MeshInfo);
+		}
+	}
+}
+
+int32 FRoomPlacement::PickRotationForFootprint(const FMeshPlacementInfo& MeshInfo, FIntPoint TargetSize)
+{
+	if (MeshInfo.AllowedRotations.Num() == 0) return 0;
+
+	// Build list of rotations that would fit the target size
+	const FIntPoint OriginalFootprint = GetFootprint(MeshInfo);
+	TArray<int32, TInlineAllocator<4>> ValidRotations;
+	for (int32 Rotation : MeshInfo.AllowedRotations)
+	{
+		FIntPoint RotatedFootprint = URoomGenerationHelpers::GetRotatedFootprint(OriginalFootprint, Rotation);
+		if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
+		{
+			ValidRotations.Add(Rotation);
+		}
+	}
+
+	// Select random rotation from valid options
+	if (ValidRotations.Num() == 0) return 0;
+	return ValidRotations[FMath::RandRange(0, ValidRotations.Num() - 1)];
+}
+
+void FRoomPlacement::CountPlacedTile(FIntPoint Size, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+{
+	int32 TileArea = Size.X * Size.Y;
+	if (TileArea >= 16) OutLargeTiles++;
+	else if (TileArea >= 4) OutMediumTiles++;
+	else if (TileArea >= 2) OutSmallTiles++;
+	else OutFillerTiles++;
+}
+#pragma endregion
@@ -5,6 +5,7 @@
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
 #include "Data/Generation/RoomGenerationTypes.h"
+#include "Data/Grid/GridRowBands.h"
 #include "Data/Room/DoorData.h" 
 #include "RoomActors/Doorway.h"
 #include "Utilities/Generation/RoomGenerationHelpers.h"
@@ -62,6 +63,7 @@ bool ARoomActor::EnsureGeneratorReady()
 		{ DebugHelpers->LogCritical(TEXT("Failed to initialize RoomGenerator!")); return false; }
 
 		DebugHelpers->LogVerbose(TEXT("Creating grid cells..."));
+		RoomGenerator->GridMemoryLayout = GridMemoryLayout;
 		RoomGenerator->CreateGrid();
 	}
 
@@ -174,13 +176,14 @@ void ARoomActor::GenerateFloorMeshes()
 		return;
 	}
 	
-	DebugHelpers->LogImportant(TEXT("Analyzing room topology..."));
-	RoomGenerator->AnalyzeTopology();
+	// Incremental when the rollback and refill touched a small part of the grid, else a full analysis
+	DebugHelpers->LogImportant(TEXT("Updating room topology..."));
+	RoomGenerator->UpdateTopology();
 	
 	// Temporary debug - see topology stats
-	int32 BorderCount = RoomGenerator->GetBorderCells().Num();
-	int32 CornerCount = RoomGenerator->GetCornerCells().Num();
-	int32 CenterCount = RoomGenerator->GetCenterCells().Num();
+	int32 BorderCount = RoomGenerator->GetBorderCellCount();
+	int32 CornerCount = RoomGenerator->GetCornerCellCount();
+	int32 CenterCount = RoomGenerator->GetZoneCellCount(ECellZone::Center);
 
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Topology Stats:   Border=%d, Corner=%d, Center=%d"),
 	
@@ -341,37 +344,33 @@ void ARoomActor::GenerateCornerMeshes()
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d corner pieces..."), PlacedCorners.Num()));
 
-    // Spawn corner meshes
-    for (const FPlacedCornerInfo& PlacedCorner : PlacedCorners)
+    // Spawn corner meshes, one bulk add per mesh batch
+    TArray<FTransform> BatchTransforms;
+    for (const FCornerMeshBatch& Batch : RoomGenerator->GetCornerBatches())
     {
-        // Get or create ISM component for corner mesh
+        // Get or create ISM component for the batch mesh
         UInstancedStaticMeshComponent* ISM = URoomSpawnerHelpers::GetOrCreateISMComponent(
             this,
-            PlacedCorner. CornerMesh,
+            Batch.CornerMesh,
             CornerMeshComponents,
             TEXT("CornerISM_"),
             true
         );
 
-        if (ISM)
+        if (!ISM)
         {
-            int32 InstanceIndex = URoomSpawnerHelpers::SpawnMeshInstance(
-                ISM,
-                PlacedCorner.Transform,
-                FVector::ZeroVector
-            );
+            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %d corners"), Batch.NumCorners));
+            continue;
+        }
 
-            if (InstanceIndex >= 0)
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s corner (instance %d)"),
-                    *UEnum::GetValueAsString(PlacedCorner.Corner), InstanceIndex));
-            }
-            else
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %s corner"),
-                    *UEnum::GetValueAsString(PlacedCorner. Corner)));
-            }
+        BatchTransforms.Reset(Batch.NumCorners);
+        for (int32 Index = Batch.FirstCorner; Index < Batch.FirstCorner + Batch.NumCorners; ++Index)
+        {
+            BatchTransforms.Add(PlacedCorners[Index].Transform);
         }
+
+        const int32 SpawnedCount = URoomSpawnerHelpers::SpawnMeshInstances(ISM, BatchTransforms, FVector::ZeroVector);
+        DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %d corners with %s"), SpawnedCount, *Batch.CornerMesh.GetAssetName()));
     }
 
     DebugHelpers->LogImportant(TEXT("Corner meshes generated successfully!"));
@@ -727,9 +726,12 @@ void ARoomActor::LogRoomStatistics()
 	
 	FIntPoint GridSize = RoomGenerator->GetGridSize();
 	int32 TotalCells = RoomGenerator->GetTotalCellCount();
-	int32 EmptyCells = RoomGenerator->GetCellCountByType(EGridCellType::ECT_Empty);
-	int32 OccupiedCells = RoomGenerator->GetCellCountByType(EGridCellType::ECT_FloorMesh);
-	float OccupancyPercent = RoomGenerator->GetOccupancyPercentage();
+	// One histogram pass instead of a count per type
+	TArray<int32> TypeCounts;
+	RoomGenerator->GetCellTypeHistogram(TypeCounts);
+	int32 EmptyCells = TypeCounts[static_cast<int32>(EGridCellType::ECT_Empty)];
+	int32 OccupiedCells = TypeCounts[static_cast<int32>(EGridCellType::ECT_FloorMesh)];
+	float OccupancyPercent = TotalCells > 0 ? (static_cast<float>(OccupiedCells) / TotalCells) * 100.0f : 0.0f;
 
 	DebugHelpers->LogStatistic(TEXT("Grid Size"), FString::Printf(TEXT("%d x %d"), GridSize.X, GridSize.Y));
 	DebugHelpers->LogStatistic(TEXT("Total Cells"), TotalCells);
@@ -783,192 +785,133 @@ void ARoomActor::UpdateVisualization()
 	if (RoomData && RoomData->ForcedEmptyFloorCells.Num() > 0)
 	{ DebugHelpers->DrawForcedEmptyCells(RoomData->ForcedEmptyFloorCells, GridSize, CellSize, RoomOrigin);}
 	
-	// Draw wall indicators (if topology analyzed and enabled)
+	// Draw wall indicators (if topology analyzed and enabled), catching up on cells edited since the last analysis
 	if (RoomGenerator->IsTopologyAnalyzed() && DebugHelpers->bShowWallDirections)
 	{
-		const TMap<FIntPoint, FCellData>& CellMetadata = RoomGenerator->GetCellMetadata();
-		DebugHelpers->DrawWallIndicators(CellMetadata, CellSize, RoomOrigin);
+		RoomGenerator->UpdateTopology();
+		DebugHelpers->DrawWallIndicators(RoomGenerator->GetCellTopology(), CellSize, RoomOrigin);
 	}
 	
 	DebugHelpers->LogVerbose(TEXT("Visualization updated."));
 }
 #pragma endregion
-#endif // WITH_EDITOR
 
-#pragma region Topology Analysis functions
-void URoomGenerator::AnalyzeTopology()
+#pragma region Benchmarks
+void ARoomActor::BenchmarkFloorTilers()
 {
-	if (!bIsInitialized)
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK FLOOR TILERS"));
+
+	if (!EnsureGeneratorReady())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::AnalyzeTopology - Generator not initialized"));
+		DebugHelpers->LogCritical(TEXT("Failed to initialize generator!"));
+		DebugHelpers->LogSectionHeader(TEXT("BENCHMARK FLOOR TILERS"));
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::AnalyzeTopology - Starting topology analysis..."));
+	DebugHelpers->LogImportant(TEXT("Timing greedy vs hierarchical floor tiling (see Output Log)..."));
+	RoomGenerator->BenchmarkFloorTilers();
 
-	// Clear existing metadata
-	CellMetadata.Empty();
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK FLOOR TILERS"));
+}
 
-	int32 CellsAnalyzed = 0;
+void ARoomActor::BenchmarkGridLayouts()
+{
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK GRID LAYOUTS"));
 
-	// Analyze each occupied cell
-	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	if (!EnsureGeneratorReady())
 	{
-		for (int32 X = 0; X < GridSize.X; ++X)
-		{
-			FIntPoint Cell(X, Y);
-			int32 Index = Y * GridSize.X + X;
-
-			// Only analyze occupied cells (has floor mesh or custom)
-			if (GridState[Index] == EGridCellType::ECT_FloorMesh || 
-			    GridState[Index] == EGridCellType::ECT_Custom)
-			{
-				// Create cell data
-				FCellData CellData(Cell);
-				CellData.bIsOccupied = true;
-
-				// Count neighbors
-				int32 NeighborCount = CountOccupiedNeighbors(Cell);
-
-				// Detect walls
-				DetectWalls(Cell, CellData);
-
-				// Classify zone
-				CellData.CellZone = ClassifyCellZone(NeighborCount, CellData.WallDirections);
-
-				// Store in metadata map
-				CellMetadata.Add(Cell, CellData);
-				CellsAnalyzed++;
-			}
-		}
+		DebugHelpers->LogCritical(TEXT("Failed to initialize generator!"));
+		DebugHelpers->LogSectionHeader(TEXT("BENCHMARK GRID LAYOUTS"));
+		return;
 	}
 
-	bTopologyAnalyzed = true;
+	DebugHelpers->LogImportant(TEXT("Timing floor, ceiling and topology per memory layout (see Output Log)..."));
+	RoomGenerator->BenchmarkGridLayouts();
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::AnalyzeTopology - Analyzed %d cells"), CellsAnalyzed);
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK GRID LAYOUTS"));
 }
 
-int32 URoomGenerator::CountOccupiedNeighbors(FIntPoint Cell) const
+void ARoomActor::BenchmarkParallelTopology()
 {
-	int32 Count = 0;
-
-	// Check all 4 cardinal directions
-	TArray<ECellDirection> Directions = { 
-		ECellDirection::North, 
-		ECellDirection::East, 
-		ECellDirection::South, 
-		ECellDirection:: West 
-	};
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK PARALLEL TOPOLOGY"));
 
-	for (ECellDirection Direction : Directions)
+	if (!EnsureGeneratorReady())
 	{
-		FIntPoint Neighbor = GetNeighborCell(Cell, Direction);
-
-		// Check if neighbor is in bounds
-		if (Neighbor.X >= 0 && Neighbor. X < GridSize.X && 
-		    Neighbor.Y >= 0 && Neighbor.Y < GridSize.Y)
-		{
-			int32 Index = Neighbor.Y * GridSize.X + Neighbor.X;
-
-			// Check if occupied
-			if (GridState[Index] == EGridCellType:: ECT_FloorMesh || 
-			    GridState[Index] == EGridCellType:: ECT_Custom)
-			{
-				Count++;
-			}
-		}
+		DebugHelpers->LogCritical(TEXT("Failed to initialize generator!"));
+		DebugHelpers->LogSectionHeader(TEXT("BENCHMARK PARALLEL TOPOLOGY"));
+		return;
 	}
 
-	return Count;
+	DebugHelpers->LogImportant(TEXT("Timing topology per row band count (see Output Log)..."));
+	RoomGenerator->BenchmarkParallelTopology();
+
+	DebugHelpers->LogSectionHeader(TEXT("BENCHMARK PARALLEL TOPOLOGY"));
 }
+#pragma endregion
+#endif // WITH_EDITOR
 
-void URoomGenerator::DetectWalls(FIntPoint Cell, FCellData& OutCellData)
+#pragma region Topology Analysis functions
+void URoomGenerator::AnalyzeTopology()
 {
-	// Check all 4 cardinal directions
-	TArray<ECellDirection> Directions = { 
-		ECellDirection::North, 
-		ECellDirection::East, 
-		ECellDirection::South, 
-		ECellDirection:: West 
-	};
-
-	for (ECellDirection Direction : Directions)
+	if (!bIsInitialized)
 	{
-		FIntPoint Neighbor = GetNeighborCell(Cell, Direction);
+		UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::AnalyzeTopology - Generator not initialized"));
+		return;
+	}
 
-		// Wall exists if: 
-		// 1. Neighbor is out of bounds, OR
-		// 2. Neighbor is empty/void
-		bool bIsWall = false;
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::AnalyzeTopology - Starting topology analysis..."));
 
-		if (Neighbor.X < 0 || Neighbor.X >= GridSize.X || 
-		    Neighbor.Y < 0 || Neighbor.Y >= GridSize.Y)
-		{
-			// Out of bounds = wall
-			bIsWall = true;
-		}
-		else
-		{
-			int32 Index = Neighbor.Y * GridSize.X + Neighbor.X;
+	if (!CellTypeBoard.IsInitialized())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::AnalyzeTopology - Cell type board not built"));
+		return;
+	}
 
-			// Check if neighbor is empty or void
-			if (GridState[Index] == EGridCellType::ECT_Empty || 
-			    GridState[Index] == EGridCellType::ECT_Void)
-			{
-				bIsWall = true;
-			}
-		}
+	// Bit-parallel sweep over the board's rows (walls and zones written together), one row band per task on large grids
+	const int32 NumBands = GridRowBands::GetNumBands(GridSize);
+	CellTopology.Init(GridSize);
+	const int32 CellsAnalyzed = CellTopology.AnalyzeAllRows(CellTypeBoard, NumBands);
+	CellTopology.BuildWallDistances(CellTypeBoard);
+	CellTopology.BuildZoneIndex(NumBands);
 
-		if (bIsWall)
-		{
-			OutCellData. WallDirections.Add(Direction);
-		}
-	}
+	bTopologyAnalyzed = true;
+	bTopologyDirty = false;
+	TopologyRevision++;
+	PublishSnapshot();
+
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::AnalyzeTopology - Analyzed %d cells"), CellsAnalyzed);
 }
 
-ECellZone URoomGenerator::ClassifyCellZone(int32 NeighborCount, const TSet<ECellDirection>& WallDirections) const
+int32 URoomGenerator::UpdateTopology()
 {
-	int32 WallCount = WallDirections.Num();
-
-	// Dead-end (3 walls)
-	if (WallCount == 3)
+	if (!bTopologyAnalyzed || CellTopology.GetSize() != GridSize)
 	{
-		return ECellZone::DeadEnd;
+		AnalyzeTopology();
+		return bTopologyAnalyzed ? CellTopology.GetNumAnalyzed() : 0;
 	}
 
-	// Corner (2 walls)
-	if (WallCount == 2)
-	{
-		// Check if walls are adjacent (90° corner) or opposite (corridor)
-		TArray<ECellDirection> Walls = WallDirections. Array();
-		
-		if (AreDirectionsAdjacent(Walls[0], Walls[1]))
-		{
-			// Adjacent walls = corner
-			// TODO: Distinguish internal vs external corners (needs more context)
-			return ECellZone::Corner;
-		}
-		else
-		{
-			// Opposite walls = corridor/border
-			return ECellZone:: Border;
-		}
-	}
+	if (!bTopologyDirty) return 0;
 
-	// Border (1 wall)
-	if (WallCount == 1)
+	// Edits spread over much of the grid: the bit-parallel full sweep beats per-cell ring reads
+	if (TopologyDirtyRect.Area() * 4 > GridSize.X * GridSize.Y)
 	{
-		return ECellZone::Border;
+		AnalyzeTopology();
+		return CellTopology.GetNumAnalyzed();
 	}
 
-	// Center (0 walls)
-	if (WallCount == 0)
-	{
-		return ECellZone::Center;
-	}
+	const int32 CellsChanged = CellTopology.UpdateCells(CellTypeBoard, TopologyDirtyRect);
+	bTopologyDirty = false;
+
+	// Distances can move far outside the dirty ring, but no farther than the largest distance in the room
+	CellTopology.UpdateWallDistances(CellTypeBoard, TopologyDirtyRect);
+	if (CellsChanged == 0) return 0;
 
-	// Default
-	return ECellZone::Center;
+	TopologyRevision++;
+	PublishSnapshot();
+
+	UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator::UpdateTopology - %d cells changed in [%d,%d]-[%d,%d]"), CellsChanged,
+		TopologyDirtyRect.Min.X, TopologyDirtyRect.Min.Y, TopologyDirtyRect.Max.X, TopologyDirtyRect.Max.Y);
+	return CellsChanged;
 }
 
 FIntPoint URoomGenerator::GetNeighborCell(FIntPoint Cell, ECellDirection Direction) const
@@ -988,57 +931,41 @@ FIntPoint URoomGenerator::GetNeighborCell(FIntPoint Cell, ECellDirection Directi
 	}
 }
 
-bool URoomGenerator::AreDirectionsAdjacent(ECellDirection Dir1, ECellDirection Dir2) const
-{
-	// Adjacent pairs: N-E, E-S, S-W, W-N
-	if ((Dir1 == ECellDirection:: North && Dir2 == ECellDirection::East) ||
-	    (Dir1 == ECellDirection::East && Dir2 == ECellDirection::North))
-		return true;
-
-	if ((Dir1 == ECellDirection::East && Dir2 == ECellDirection::South) ||
-	    (Dir1 == ECellDirection:: South && Dir2 == ECellDirection::East))
-		return true;
-
-	if ((Dir1 == ECellDirection::South && Dir2 == ECellDirection::West) ||
-	    (Dir1 == ECellDirection::West && Dir2 == ECellDirection:: South))
-		return true;
-
-	if ((Dir1 == ECellDirection::West && Dir2 == ECellDirection::North) ||
-	    (Dir1 == ECellDirection::North && Dir2 == ECellDirection::West))
-		return true;
-
-	return false;
-}
-
 //========================================================================
 // TOPOLOGY QUERY FUNCTIONS
 //========================================================================
 
-TArray<FIntPoint> URoomGenerator:: GetCellsByZone(ECellZone Zone) const
+int32 URoomGenerator::GetWallDistance(FIntPoint Cell) const
 {
-	TArray<FIntPoint> Results;
-
-	for (const auto& Pair : CellMetadata)
-	{
-		if (Pair.Value.CellZone == Zone)
-		{
-			Results.Add(Pair.Key);
-		}
-	}
+	return CellTopology.IsValidCell(Cell) ? CellTopology.GetWallDistance(CellTopology.IndexOf(Cell)) : 0;
+}
 
+TArray<FIntPoint> URoomGenerator::GetCellsByWallDistance(int32 MinDistance, int32 MaxDistance) const
+{
+	TArray<FIntPoint> Results;
+	CellTopology.GetCellsByWallDistance(MinDistance, MaxDistance, Results);
 	return Results;
 }
 
+TArray<FIntPoint> URoomGenerator:: GetCellsByZone(ECellZone Zone) const
+{
+	return TArray<FIntPoint>(GetZoneCellsView(Zone));
+}
+
 TArray<FIntPoint> URoomGenerator::GetBorderCells() const
 {
-	TArray<FIntPoint> Results;
+	return TArray<FIntPoint>(GetBorderCellsView());
+}
+
+TMap<FIntPoint, FCellData> URoomGenerator::GetCellMetadata() const
+{
+	const TConstArrayView<FIntPoint> AnalyzedCells = CellTopology.GetZoneCells(ECellZone::Center, ECellZone::DeadEnd);
 
-	for (const auto& Pair : CellMetadata)
+	TMap<FIntPoint, FCellData> Results;
+	Results.Reserve(AnalyzedCells.Num());
+	for (const FIntPoint& Cell : AnalyzedCells)
 	{
-		if (Pair.Value. IsBorder())
-		{
-			Results.Add(Pair.Key);
-		}
+		Results.Add(Cell, CellTopology.MakeCellData(Cell));
 	}
 
 	return Results;
@@ -1046,11 +973,12 @@ TArray<FIntPoint> URoomGenerator::GetBorderCells() const
 
 TArray<FIntPoint> URoomGenerator::GetCornerCells() const
 {
-	return GetCellsByZone(ECellZone::Corner);
+	return TArray<FIntPoint>(GetCornerCellsView());
 }
 
 TArray<FIntPoint> URoomGenerator::GetCenterCells() const
 {
-	return GetCellsByZone(ECellZone::Center);
+	return TArray<FIntPoint>(GetCenterCellsView());
 }
+
 #pragma endregion
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "DrawDebugHelpers.h"
 #include "Components/TextRenderComponent.h"
 #include "Data/Generation/RoomGenerationTypes.h"
+#include "Data/Grid/GridTopologyStore.h"
 #include "Engine/Engine.h"
 
 UDebugHelpers::UDebugHelpers()
@@ -350,7 +351,7 @@ void UDebugHelpers::LogSectionHeader(const FString& Title)
 }
 #pragma endregion
 
-void UDebugHelpers::DrawWallIndicators(const TMap<FIntPoint, FCellData>& CellMetadata, float CellSize, FVector OriginLocation)
+void UDebugHelpers::DrawWallIndicators(const FGridTopologyStore& CellTopology, float CellSize, FVector OriginLocation)
 {
 	if (!bEnableDebug || !bShowWallDirections)
 	{
@@ -366,24 +367,32 @@ void UDebugHelpers::DrawWallIndicators(const TMap<FIntPoint, FCellData>& CellMet
 	int32 WallCount = 0;
 	int32 OpeningCount = 0;
 
-	for (const auto& Pair : CellMetadata)
+	for (int32 Index = 0; Index < CellTopology.Num(); ++Index)
 	{
-		const FCellData& CellData = Pair.Value;
-		FVector CellCenter = GridToWorldPosition(CellData. Coordinates, CellSize, OriginLocation);
+		const uint8 WallMask = CellTopology.GetWallMask(Index);
+		const uint8 OpenMask = CellTopology.GetOpenMask(Index);
+		if ((WallMask | OpenMask) == 0) continue;
+
+		FVector CellCenter = GridToWorldPosition(CellTopology.CellOf(Index), CellSize, OriginLocation);
 		CellCenter.Z += CellBoxZOffset;
 
-		// Draw wall indicators (red arrows)
-		for (ECellDirection Direction : CellData. WallDirections)
+		for (uint8 Dir = 0; Dir < 4; ++Dir)
 		{
-			DrawDirectionArrow(CellCenter, Direction, WallArrowColor, CellSize);
-			WallCount++;
-		}
+			const ECellDirection Direction = static_cast<ECellDirection>(Dir);
 
-		// Draw opening indicators (cyan arrows)
-		for (ECellDirection Direction : CellData.OpenDirections)
-		{
-			DrawDirectionArrow(CellCenter, Direction, OpeningArrowColor, CellSize);
-			OpeningCount++;
+			// Draw wall indicators (red arrows)
+			if (WallMask & GridDirectionMask::Of(Direction))
+			{
+				DrawDirectionArrow(CellCenter, Direction, WallArrowColor, CellSize);
+				WallCount++;
+			}
+
+			// Draw opening indicators (cyan arrows)
+			if (OpenMask & GridDirectionMask::Of(Direction))
+			{
+				DrawDirectionArrow(CellCenter, Direction, OpeningArrowColor, CellSize);
+				OpeningCount++;
+			}
 		}
 	}
 
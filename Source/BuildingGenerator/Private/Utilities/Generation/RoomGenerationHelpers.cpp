@@ -55,26 +55,23 @@ int32 URoomGenerationHelpers::CoordinateToIndex(FIntPoint Coord, int32 GridWidth
 bool URoomGenerationHelpers::IsAreaAvailable(const TArray<EGridCellType>& GridState, FIntPoint GridSize,
 	FIntPoint StartCoord, FIntPoint Size, EGridCellType RequiredType)
 {
-	// Check if entire area fits within grid
+	// Validate the whole rect once (start, extent, and backing array) instead of per cell
+	if (!IsValidGridCoordinate(StartCoord, GridSize) || Size.X <= 0 || Size.Y <= 0)
+		return false;
+
 	if (StartCoord.X + Size.X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y)
 		return false;
 
-	// Check if start coordinate is valid
-	if (!IsValidGridCoordinate(StartCoord, GridSize))
+	if (GridState.Num() < GridSize.X * GridSize.Y)
 		return false;
 
 	// Check if any cell in the area is not the required type
-	for (int32 Y = 0; Y < Size.Y; ++Y)
+	const EGridCellType* Row = GridState.GetData() + CoordinateToIndex(StartCoord, GridSize.X);
+	for (int32 Y = 0; Y < Size.Y; ++Y, Row += GridSize.X)
 	{
 		for (int32 X = 0; X < Size.X; ++X)
 		{
-			FIntPoint CheckCoord(StartCoord.X + X, StartCoord.Y + Y);
-			int32 Index = CoordinateToIndex(CheckCoord, GridSize. X);
-
-			if (! GridState. IsValidIndex(Index))
-				return false;
-
-			if (GridState[Index] != RequiredType)
+			if (Row[X] != RequiredType)
 				return false;
 		}
 	}
@@ -85,25 +82,36 @@ bool URoomGenerationHelpers::IsAreaAvailable(const TArray<EGridCellType>& GridSt
 void URoomGenerationHelpers::MarkCellsOccupied(TArray<EGridCellType>& GridState, FIntPoint GridSize, FIntPoint StartCoord,
 FIntPoint Size, EGridCellType CellType)
 {
+	// Clip area to grid once
+	const int32 MinX = FMath::Max(StartCoord.X, 0);
+	const int32 MinY = FMath::Max(StartCoord.Y, 0);
+	const int32 MaxX = FMath::Min(StartCoord.X + Size.X, GridSize.X);
+	const int32 MaxY = FMath::Min(StartCoord.Y + Size.Y, GridSize.Y);
+	if (MinX >= MaxX || MinY >= MaxY || GridState.Num() < GridSize.X * GridSize.Y)
+		return;
+
 	// Mark all cells in area
-	for (int32 Y = 0; Y < Size.Y; ++Y)
+	for (int32 Y = MinY; Y < MaxY; ++Y)
 	{
-		for (int32 X = 0; X < Size.X; ++X)
+		EGridCellType* Row = GridState.GetData() + Y * GridSize.X;
+		for (int32 X = MinX; X < MaxX; ++X)
 		{
-			FIntPoint CellCoord(StartCoord. X + X, StartCoord. Y + Y);
+			Row[X] = CellType;
+		}
+	}
+}
 
-			// Validate coordinate
-			if (!IsValidGridCoordinate(CellCoord, GridSize))
-				continue;
+bool URoomGenerationHelpers::IsAreaAvailableInBitboard(const FGridBitboard& Board, FIntPoint StartCoord, FIntPoint Size,
+EGridCellType RequiredType)
+{
+	const FIntPoint GridSize(Board.GetWidth(), Board.GetHeight());
+	if (!IsValidGridCoordinate(StartCoord, GridSize) || Size.X <= 0 || Size.Y <= 0)
+		return false;
 
-			int32 Index = CoordinateToIndex(CellCoord, GridSize.X);
+	if (StartCoord.X + Size.X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y)
+		return false;
 
-			if (GridState.IsValidIndex(Index))
-			{
-				GridState[Index] = CellType;
-			}
-		}
-	}
+	return Board.IsRectSet(FGridBitboard::PlaneOf(RequiredType), StartCoord.X, StartCoord.Y, Size.X, Size.Y);
 }
 
 bool URoomGenerationHelpers::TryPlaceMeshInGrid(TArray<EGridCellType>& GridState, FIntPoint GridSize, FIntPoint StartCoord,
@@ -168,26 +176,33 @@ FRotator URoomGenerationHelpers::GetWallRotationForEdge(EWallEdge Edge)
 
 FVector URoomGenerationHelpers::CalculateWallPosition(EWallEdge Edge, int32 StartCell, int32 SpanLength, FIntPoint GridSize,
 float CellSize, float NorthOffset, float SouthOffset, float EastOffset, float WestOffset)
+{
+	return CalculateWallPositionOnLine(Edge, GetEdgeLine(Edge, GridSize), StartCell, SpanLength, CellSize,
+		NorthOffset, SouthOffset, EastOffset, WestOffset);
+}
+
+FVector URoomGenerationHelpers::CalculateWallPositionOnLine(EWallEdge Edge, int32 Line, int32 StartCell, int32 SpanLength,
+float CellSize, float NorthOffset, float SouthOffset, float EastOffset, float WestOffset)
 {
 	float HalfSpan = (SpanLength * CellSize) * 0.5f;
 	FVector Position = FVector:: ZeroVector;
 
 	switch (Edge)
 	{
-		case EWallEdge::North:  // North wall:  X = GridSize.X
-		Position = FVector((GridSize.X * CellSize) + NorthOffset, (StartCell * CellSize) + HalfSpan,0.0f);
+		case EWallEdge::North:  // North-facing line: X = Line (GridSize.X on the bounding edge)
+		Position = FVector((Line * CellSize) + NorthOffset, (StartCell * CellSize) + HalfSpan,0.0f);
 		break;
 
-		case EWallEdge::South:  // South wall: X = 0
-		Position = FVector(0.0f + SouthOffset,(StartCell * CellSize) + HalfSpan, 0.0f);
+		case EWallEdge::South:  // South-facing line: X = Line (0 on the bounding edge)
+		Position = FVector((Line * CellSize) + SouthOffset,(StartCell * CellSize) + HalfSpan, 0.0f);
 		break;
 
-		case EWallEdge::East:   // East wall: Y = GridSize.Y
-		Position = FVector((StartCell * CellSize) + HalfSpan, (GridSize.Y * CellSize) + EastOffset, 0.0f);
+		case EWallEdge::East:   // East-facing line: Y = Line (GridSize.Y on the bounding edge)
+		Position = FVector((StartCell * CellSize) + HalfSpan, (Line * CellSize) + EastOffset, 0.0f);
 		break;
 
-		case EWallEdge::West:   // West wall: Y = 0
-		Position = FVector((StartCell * CellSize) + HalfSpan, 0.0f + WestOffset, 0.0f);
+		case EWallEdge::West:   // West-facing line: Y = Line (0 on the bounding edge)
+		Position = FVector((StartCell * CellSize) + HalfSpan, (Line * CellSize) + WestOffset, 0.0f);
 		break;
 
 		default:
@@ -197,6 +212,36 @@ float CellSize, float NorthOffset, float SouthOffset, float EastOffset, float We
 	return Position;
 }
 
+int32 URoomGenerationHelpers::GetEdgeLine(EWallEdge Edge, FIntPoint GridSize)
+{
+	switch (Edge)
+	{
+		case EWallEdge::North:	return GridSize.X;
+		case EWallEdge::East:	return GridSize.Y;
+		default:				return 0;
+	}
+}
+
+EWallEdge URoomGenerationHelpers::GetWallEdgeForSide(ECellDirection Side)
+{
+	switch (Side)
+	{
+		case ECellDirection::East:	return EWallEdge::North;	// +X
+		case ECellDirection::West:	return EWallEdge::South;	// -X
+		case ECellDirection::North:	return EWallEdge::East;		// +Y
+		default:					return EWallEdge::West;		// -Y
+	}
+}
+
+ECornerPosition URoomGenerationHelpers::GetCornerPositionForSides(ECellDirection SideAlongY, ECellDirection SideAlongX)
+{
+	// Grid +X is North and grid +Y is East in wall/corner terms
+	const bool bNorth = SideAlongY == ECellDirection::East;
+	const bool bEast = SideAlongX == ECellDirection::North;
+	if (bNorth) return bEast ? ECornerPosition::NorthEast : ECornerPosition::NorthWest;
+	return bEast ? ECornerPosition::SouthEast : ECornerPosition::SouthWest;
+}
+
 FVector URoomGenerationHelpers::CalculateDoorwayPosition(EWallEdge Edge, int32 StartCell, 
 int32 WidthInCells,	FIntPoint GridSize, float CellSize)
 {
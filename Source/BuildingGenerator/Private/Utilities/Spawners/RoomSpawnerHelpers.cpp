@@ -94,16 +94,11 @@ const FVector& WorldOffset)
 int32 URoomSpawnerHelpers::SpawnMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
 const FVector& WorldOffset)
 {
-	if (!ISMComponent) return 0;
-	int32 SpawnedCount = 0;
+	if (!ISMComponent || LocalTransforms.Num() == 0) return 0;
 
-	for (const FTransform& LocalTransform : LocalTransforms)
-	{
-		int32 InstanceIndex = SpawnMeshInstance(ISMComponent, LocalTransform, WorldOffset);
-		if (InstanceIndex >= 0) SpawnedCount++;
-	}
-
-	return SpawnedCount;
+	// One bulk add (single render state update) instead of an AddInstance per transform
+	ISMComponent->AddInstances(LocalToWorldTransforms(LocalTransforms, WorldOffset), false);
+	return LocalTransforms.Num();
 }
   
 // TRANSFORM UTILITIES
@@ -41,6 +41,23 @@ enum class EDoorwaySideFill :  uint8
 	CornerPieces    UMETA(DisplayName = "Corner Pieces")
 };
 
+/* Tiling strategy used by URoomGenerator::GenerateFloor and GenerateCeiling */
+UENUM(BlueprintType)
+enum class EFloorTilingMode : uint8
+{
+	Greedy          UMETA(DisplayName = "Greedy (Pass Per Footprint)"),
+	Hierarchical    UMETA(DisplayName = "Hierarchical (Single Pass Subdivision)")
+};
+
+/* Which cells URoomGenerator::GenerateCeiling covers */
+UENUM(BlueprintType)
+enum class ECeilingCoverageMode : uint8
+{
+	FullGrid        UMETA(DisplayName = "Full Grid (Bounding Rectangle)"),
+	FollowFloor     UMETA(DisplayName = "Follow Floor Mask"),
+	MirrorFloor     UMETA(DisplayName = "Mirror Floor Layout")
+};
+
 
 // --- Mesh Placement Info  ---
 USTRUCT(BlueprintType)
@@ -116,13 +133,14 @@ struct FGeneratorWallSegment
 	GENERATED_BODY()
 
 	EWallEdge Edge;
+	int32 Line;  // Grid line the wall stands on (URoomGenerationHelpers::GetEdgeLine for bounding walls)
 	int32 StartCell;
 	int32 SegmentLength;
 	FTransform BaseTransform;
 	UStaticMesh* BaseMesh;
 	const FWallModule* WallModule;  // Reference to module for Middle/Top
 
-	FGeneratorWallSegment() : Edge(EWallEdge::North), StartCell(0), SegmentLength(0), BaseMesh(nullptr), WallModule(nullptr) {}
+	FGeneratorWallSegment() : Edge(EWallEdge::North), Line(0), StartCell(0), SegmentLength(0), BaseMesh(nullptr), WallModule(nullptr) {}
 };
 
 // Struct for complex wall modules (Base, Middle, Top)
@@ -353,11 +371,38 @@ struct FPlacedCornerInfo
 	UPROPERTY()
 	FTransform Transform;
 
+	// Outline vertex of the corner (grid lines, cell (X, Y) spans [X, X + 1] x [Y, Y + 1])
+	UPROPERTY()
+	FIntPoint GridVertex;
+
+	// Concave corner (three floor quadrants around the vertex) instead of a convex one
+	UPROPERTY()
+	bool bInnerCorner;
+
 	FPlacedCornerInfo()
 		: Corner(ECornerPosition:: SouthWest)
+		, GridVertex(FIntPoint::ZeroValue)
+		, bInnerCorner(false)
 	{}
 };
 
+/* Contiguous range of placed corners sharing one mesh (spawned as one bulk instance add) */
+USTRUCT(BlueprintType)
+struct FCornerMeshBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSoftObjectPtr<UStaticMesh> CornerMesh;
+
+	// Range into the generator's placed corners
+	UPROPERTY()
+	int32 FirstCorner = 0;
+
+	UPROPERTY()
+	int32 NumCorners = 0;
+};
+
 /* Information about a placed ceiling tile */
 USTRUCT(BlueprintType)
 struct FPlacedCeilingInfo
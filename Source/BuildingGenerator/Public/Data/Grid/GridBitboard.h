@@ -0,0 +1,235 @@
+// GridBitboard.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+
+/* Extra room layers stored as bit planes after the cell type planes (see FGridBitboard::PlaneOf(EGridLayer)) */
+enum class EGridLayer : uint8
+{
+	Ceiling,	// Set = ceiling cell occupied (tiled or outside the ceiling mask)
+	Clutter,	// Set = interior content placed on the cell
+	Reserved	// Set = cell kept free of generated content (forced empty regions)
+};
+
+/* Word-wise combine applied by FGridBitboard's cross-plane operations */
+enum class EGridPlaneOp : uint8
+{
+	And,		// A & B
+	Or,			// A | B
+	AndNot,		// A & ~B
+	Xor			// A ^ B
+};
+
+/**
+ * FGridBitboard - Packed per-cell-type occupancy bits for a room grid
+ *
+ * Purpose:
+ *   - Mirrors the room's cell types as one bit plane per cell type, plus optional layer planes (ceiling, clutter, reserved)
+ *   - Turns "is this WxH rectangle all of type T" into a mask test per row word instead of a compare per cell
+ *   - Cross-layer queries ("floor present AND ceiling absent") are a straight loop of word ops over two planes
+ *
+ * Layout:
+ *   - Each plane is Height rows of WordsPerRow 64-bit words (cell X lives in bit X % 64 of word X / 64)
+ *   - All planes share one 64-byte aligned allocation; each plane starts on a 64-byte boundary:
+ *     Words[Plane * PlaneStride + Y * WordsPerRow + Word]
+ *   - Bits past Width in the last word of a row, and the padding words after each plane, are always zero
+ *
+ * Rect functions expect a rectangle already validated against the grid bounds (callers clip/validate once)
+ */
+struct BUILDINGGENERATOR_API FGridBitboard
+{
+	/** One plane per EGridCellType value */
+	static constexpr int32 NumCellTypePlanes = static_cast<int32>(EGridCellType::ECT_Void) + 1;
+
+	/** One plane per EGridLayer value */
+	static constexpr int32 NumLayerPlanes = static_cast<int32>(EGridLayer::Reserved) + 1;
+
+	/** Cell type planes followed by layer planes */
+	static constexpr int32 NumGridPlanes = NumCellTypePlanes + NumLayerPlanes;
+
+	/** Words per alignment block (plane starts are padded to a multiple of this) */
+	static constexpr int32 PlaneAlignWords = 64 / sizeof(uint64);
+
+	FGridBitboard() = default;
+
+	/** Allocate NumPlanes cleared planes for a grid of InSize cells */
+	void Init(FIntPoint InSize, int32 InNumPlanes = NumCellTypePlanes);
+
+	/** Release storage */
+	void Reset();
+
+	FORCEINLINE bool IsInitialized() const { return Words.Num() > 0; }
+	FORCEINLINE int32 GetWidth() const { return Width; }
+	FORCEINLINE int32 GetHeight() const { return Height; }
+	FORCEINLINE int32 GetWordsPerRow() const { return WordsPerRow; }
+	FORCEINLINE int32 GetNumPlanes() const { return NumPlanes; }
+	FORCEINLINE int32 GetPlaneStride() const { return PlaneStride; }
+
+	/** Plane index for a cell type */
+	static constexpr int32 PlaneOf(EGridCellType CellType) { return static_cast<int32>(CellType); }
+
+	/** Plane index for a layer (requires a board initialized with NumGridPlanes) */
+	static FORCEINLINE int32 PlaneOf(EGridLayer Layer) { return NumCellTypePlanes + static_cast<int32>(Layer); }
+
+	/** Mask with NumBits set starting at FirstBit (FirstBit + NumBits <= 64) */
+	static FORCEINLINE uint64 MakeSpanMask(int32 FirstBit, int32 NumBits)
+	{
+		return (NumBits >= 64 ? ~0ull : ((1ull << NumBits) - 1ull)) << FirstBit;
+	}
+
+	/** Raw row access */
+	FORCEINLINE uint64* GetRow(int32 Plane, int32 Y) { return Words.GetData() + Plane * PlaneStride + Y * WordsPerRow; }
+	FORCEINLINE const uint64* GetRow(int32 Plane, int32 Y) const { return Words.GetData() + Plane * PlaneStride + Y * WordsPerRow; }
+
+#pragma region Cell Access
+	FORCEINLINE bool GetBit(int32 Plane, int32 X, int32 Y) const
+	{
+		return (GetRow(Plane, Y)[X >> 6] >> (X & 63)) & 1ull;
+	}
+
+	FORCEINLINE void SetBit(int32 Plane, int32 X, int32 Y, bool bValue)
+	{
+		uint64& Word = GetRow(Plane, Y)[X >> 6];
+		const uint64 Bit = 1ull << (X & 63);
+		Word = bValue ? (Word | Bit) : (Word & ~Bit);
+	}
+
+	/** Move one cell from OldType's plane to NewType's plane */
+	FORCEINLINE void SetCellType(int32 X, int32 Y, EGridCellType OldType, EGridCellType NewType)
+	{
+		SetBit(PlaneOf(OldType), X, Y, false);
+		SetBit(PlaneOf(NewType), X, Y, true);
+	}
+#pragma endregion
+
+#pragma region Row Scans
+	/** First X >= StartX whose bit is set in row Y of Plane, or INDEX_NONE (skips whole words of clear cells) */
+	FORCEINLINE int32 FindNextSet(int32 Plane, int32 Y, int32 StartX) const
+	{
+		if (StartX >= Width) return INDEX_NONE;
+		const uint64* Row = GetRow(Plane, Y);
+		int32 W = StartX >> 6;
+		uint64 Word = Row[W] & (~0ull << (StartX & 63));
+		while (Word == 0)
+		{
+			if (++W >= WordsPerRow) return INDEX_NONE;
+			Word = Row[W];
+		}
+		return (W << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+	}
+
+	/** First X >= StartX whose bit is clear in row Y of Plane, or INDEX_NONE (skips whole words of set cells) */
+	FORCEINLINE int32 FindNextClear(int32 Plane, int32 Y, int32 StartX) const
+	{
+		if (StartX >= Width) return INDEX_NONE;
+		const uint64* Row = GetRow(Plane, Y);
+		int32 W = StartX >> 6;
+		uint64 Word = ~Row[W] & (~0ull << (StartX & 63));
+		while (Word == 0)
+		{
+			if (++W >= WordsPerRow) return INDEX_NONE;
+			Word = ~Row[W];
+		}
+		const int32 X = (W << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+		return X < Width ? X : INDEX_NONE;
+	}
+#pragma endregion
+
+#pragma region Rect Operations
+	/** True if every cell of the rect is set in Plane */
+	bool IsRectSet(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY) const;
+
+	/** True if no cell of the rect is set in Plane */
+	bool IsRectClear(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY) const;
+
+	/** Set or clear every cell of the rect in Plane */
+	void SetRect(int32 Plane, int32 X, int32 Y, int32 SizeX, int32 SizeY, bool bValue);
+
+	/** Clear the rect from every cell type plane and set it in NewType's plane */
+	void SetRectType(int32 X, int32 Y, int32 SizeX, int32 SizeY, EGridCellType NewType);
+#pragma endregion
+
+#pragma region Plane Operations
+	/** Set or clear a whole plane */
+	void FillPlane(int32 Plane, bool bValue);
+
+	/** Dst |= Src, then clear Src (word-wise retype of every Src cell) */
+	void MovePlaneInto(int32 SrcPlane, int32 DstPlane);
+
+	/** Number of set cells in Plane */
+	int32 CountSet(int32 Plane) const;
+
+	/** DstPlane = union of SourcePlanes of Source (same size, may be this board), inverted if bInvert @return Number of set cells written */
+	int32 CopyPlaneUnion(int32 DstPlane, const FGridBitboard& Source, TConstArrayView<int32> SourcePlanes, bool bInvert);
+
+	/** Rebuild every cell type plane from a row-major cell array (layer planes are left untouched) */
+	void BuildFromCells(const TArray<EGridCellType>& Cells);
+#pragma endregion
+
+#pragma region Cross-Plane Operations
+	/** DstPlane = PlaneA Op PlaneB over whole planes (Dst may alias either source) */
+	void CombinePlanes(int32 DstPlane, int32 PlaneA, int32 PlaneB, EGridPlaneOp Op);
+
+	/** Number of cells set in PlaneA Op PlaneB, without writing a plane */
+	int32 CountCombined(int32 PlaneA, int32 PlaneB, EGridPlaneOp Op) const;
+#pragma endregion
+
+private:
+	/** Calls Op(Word, Mask) for every word touched by [X, X + SizeX) in the given row */
+	template<typename OpType>
+	FORCEINLINE static bool ForEachSpanWord(const uint64* Row, int32 X, int32 SizeX, OpType&& Op)
+	{
+		const int32 FirstWord = X >> 6;
+		const int32 LastWord = (X + SizeX - 1) >> 6;
+		for (int32 W = FirstWord; W <= LastWord; ++W)
+		{
+			const int32 Lo = (W == FirstWord) ? (X & 63) : 0;
+			const int32 Hi = (W == LastWord) ? ((X + SizeX - 1) & 63) + 1 : 64;
+			if (!Op(Row[W], MakeSpanMask(Lo, Hi - Lo))) return false;
+		}
+		return true;
+	}
+
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 WordsPerRow = 0;
+	int32 NumPlanes = 0;
+	int32 PlaneStride = 0;
+	TArray<uint64, TAlignedHeapAllocator<64>> Words;
+};
+
+/**
+ * Walkable cell types: open neighbours for topology, the cells reachability floods
+ *   - Every other type bounds the room: unfilled Empty gaps, Void, and forced-empty regions, which are written as
+ *     WallMesh, so the cells along an L notch or courtyard get walls (Border/InternalCorner) instead of Center,
+ *     matching the outline walls and corners are traced along
+ */
+namespace GridWalkable
+{
+	static constexpr int32 Planes[] = {
+		FGridBitboard::PlaneOf(EGridCellType::ECT_FloorMesh),
+		FGridBitboard::PlaneOf(EGridCellType::ECT_Custom),
+		FGridBitboard::PlaneOf(EGridCellType::ECT_Doorway)
+	};
+
+	constexpr bool IsWalkable(EGridCellType CellType)
+	{
+		for (const int32 Plane : Planes) { if (Plane == FGridBitboard::PlaneOf(CellType)) return true; }
+		return false;
+	}
+
+	static_assert(!IsWalkable(EGridCellType::ECT_WallMesh), "Forced-empty cut-outs (L rooms, courtyards) are WallMesh and must bound the room");
+	static_assert(!IsWalkable(EGridCellType::ECT_Empty) && !IsWalkable(EGridCellType::ECT_Void), "Empty and Void cells bound the room");
+
+	/** Walkable bits of word W of row Y (bits past the width stay zero) */
+	FORCEINLINE uint64 GetRowWord(const FGridBitboard& Board, int32 Y, int32 W)
+	{
+		uint64 Word = 0;
+		for (const int32 Plane : Planes) { Word |= Board.GetRow(Plane, Y)[W]; }
+		return Word;
+	}
+
+	FORCEINLINE bool IsSet(const FGridBitboard& Board, int32 X, int32 Y) { return (GetRowWord(Board, Y, X >> 6) >> (X & 63)) & 1ull; }
+}
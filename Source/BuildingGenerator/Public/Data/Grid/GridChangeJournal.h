@@ -0,0 +1,102 @@
+// GridChangeJournal.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+#include "Data/Grid/GridChunkStore.h"
+
+/* Generation phases that write the room grid (journal sections are tagged with one) */
+enum class EGridPhase : uint8
+{
+	ForcedEmpty,		// Forced empty regions and cells
+	ForcedPlacement,	// Designer-forced floor meshes
+	FloorFill,			// Greedy / hierarchical / gap fill
+	Doorways			// Doorway cells
+};
+
+/**
+ * FGridChangeJournal - Undo log of cell-range writes to a room grid, grouped by generation phase
+ *
+ * Purpose:
+ *   - Rolling a phase back costs O(cells it changed) instead of rescanning the grid or re-running CreateGrid
+ *     and every earlier phase; the phase can then simply be generated again
+ *
+ * Layout:
+ *   - One entry per rect write, recorded before the write with the rect's previous contents
+ *   - Previous contents are a single type when uniform (every placement), else a row-major copy in PrevCells
+ *   - Phase marks hold the first entry of each section and the caller's record count at that point
+ *
+ * Rewinding a phase undoes it and every phase recorded after it, newest write first, so overlapping writes restore exactly
+ */
+struct BUILDINGGENERATOR_API FGridChangeJournal
+{
+	FGridChangeJournal() = default;
+
+	/** Drop every entry and phase mark and stop recording */
+	void Reset();
+
+	FORCEINLINE bool IsRecording() const { return bRecording; }
+	FORCEINLINE int32 GetNumEntries() const { return Entries.Num(); }
+	FORCEINLINE int32 GetNumPhases() const { return Phases.Num(); }
+
+	/** Start a new section (recording starts with the first phase) @param NumRecords - Caller's placed-record count, returned by GetPhaseRecordMark */
+	void BeginPhase(EGridPhase Phase, int32 NumRecords = 0);
+
+	/** Keep recording into the newest section when it is already Phase, else BeginPhase (repeated passes share one section) */
+	void ContinuePhase(EGridPhase Phase, int32 NumRecords = 0);
+
+	/** Most recent section of Phase, INDEX_NONE if none */
+	int32 FindLastPhase(EGridPhase Phase) const;
+
+	/** Kind of the section at PhaseIndex */
+	FORCEINLINE EGridPhase GetPhase(int32 PhaseIndex) const { return Phases[PhaseIndex].Phase; }
+
+	/** Writes recorded in the section at PhaseIndex (a section with none changed nothing and rewinds as a no-op) */
+	FORCEINLINE int32 GetPhaseNumEntries(int32 PhaseIndex) const
+	{
+		const int32 EndEntry = Phases.IsValidIndex(PhaseIndex + 1) ? Phases[PhaseIndex + 1].FirstEntry : Entries.Num();
+		return EndEntry - Phases[PhaseIndex].FirstEntry;
+	}
+
+	/** Record count passed to BeginPhase for the section at PhaseIndex */
+	FORCEINLINE int32 GetPhaseRecordMark(int32 PhaseIndex) const { return Phases[PhaseIndex].NumRecords; }
+
+	/** Cells changed from PhaseIndex onwards (what a rewind to it restores) */
+	int32 CountChangedCells(int32 PhaseIndex) const;
+
+#pragma region Recording
+	/** Record a rect (inside the grid) whose current cells are all PrevType, before it is overwritten */
+	void RecordUniform(FIntPoint Start, FIntPoint Size, EGridCellType PrevType);
+
+	/** Record a rect (inside the grid) before it is overwritten, reading its current cells from Cells */
+	void RecordCells(FIntPoint Start, FIntPoint Size, const FGridChunkStore& Cells);
+#pragma endregion
+
+	/**
+	 * Undo the section at PhaseIndex and every later one, then drop them
+	 * Restore(Start, Size, Type) is called per uniform run, newest write first; nothing is recorded while it runs
+	 * @return Cells restored */
+	int32 Rewind(int32 PhaseIndex, TFunctionRef<void(FIntPoint Start, FIntPoint Size, EGridCellType Type)> Restore);
+
+private:
+	struct FEntry
+	{
+		FIntPoint Start;
+		FIntPoint Size;
+		EGridCellType PrevType;	// Previous type when uniform
+		int32 PrevOffset;		// Else first cell in PrevCells (INDEX_NONE when uniform)
+	};
+
+	struct FPhaseMark
+	{
+		EGridPhase Phase;
+		int32 FirstEntry;
+		int32 NumRecords;
+	};
+
+	TArray<FEntry> Entries;
+	TArray<EGridCellType> PrevCells;
+	TArray<FPhaseMark> Phases;
+	bool bRecording = false;
+};
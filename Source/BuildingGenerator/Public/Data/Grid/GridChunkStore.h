@@ -0,0 +1,126 @@
+// GridChunkStore.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+
+/**
+ * FGridChunkStore - Sparse chunked storage for a room's cell types
+ *
+ * Purpose:
+ *   - Replaces one flat X*Y cell array so the cell type storage itself only pays for detail
+ *   - Only this store is sparse: the bitboard mirror and topology store stay dense (bit planes plus per-cell topology arrays, well over 10 bytes per cell)
+ *   - A chunk whose cells all share one type is elided: it is stored as that single type and owns no cell memory
+ *   - A chunk is allocated the first time a write makes it mixed, and released as soon as a write makes it uniform again
+ *
+ * Layout:
+ *   - ChunkSize x ChunkSize chunks, chunk (CX, CY) at index CY * ChunksX + CX
+ *   - Allocated chunks live in a slot pool; cell order inside a slot follows EGridMemoryLayout
+ *     (every layout is separable, so a local index is one X table lookup OR'd with one Y table lookup)
+ *   - Each slot keeps per-type cell counts so uniformity checks are O(1)
+ *   - Edge chunks hang over the grid; cells past the grid bounds are never read or counted
+ *
+ * Cell/rect functions expect coordinates already validated against the grid bounds (callers clip/validate once)
+ */
+struct BUILDINGGENERATOR_API FGridChunkStore
+{
+	static constexpr int32 ChunkShift = 4;
+	static constexpr int32 ChunkSize = 1 << ChunkShift;
+	static constexpr int32 ChunkMask = ChunkSize - 1;
+	static constexpr int32 CellsPerChunk = ChunkSize * ChunkSize;
+	static constexpr int32 NumCellTypes = static_cast<int32>(EGridCellType::ECT_Void) + 1;
+
+	FGridChunkStore() = default;
+
+	/** Size the store for InSize cells, every chunk elided as FillType */
+	void Init(FIntPoint InSize, EGridCellType FillType, EGridMemoryLayout InLayout = EGridMemoryLayout::RowMajor);
+
+	/** Release all storage */
+	void Reset();
+
+	FORCEINLINE bool IsInitialized() const { return UniformTypes.Num() > 0; }
+	FORCEINLINE FIntPoint GetSize() const { return Size; }
+	FORCEINLINE EGridMemoryLayout GetLayout() const { return Layout; }
+	FORCEINLINE int32 GetChunksX() const { return ChunksX; }
+	FORCEINLINE int32 GetChunksY() const { return ChunksY; }
+	FORCEINLINE int32 GetNumChunks() const { return UniformTypes.Num(); }
+	FORCEINLINE int32 GetNumAllocatedChunks() const { return ChunkSlots.Num() - NumElided; }
+
+	/** Bytes held by the store (chunk tables plus allocated slots) */
+	SIZE_T GetAllocatedSize() const;
+
+#pragma region Cell Access
+	FORCEINLINE EGridCellType GetCell(int32 X, int32 Y) const
+	{
+		const int32 Chunk = ChunkIndexOf(X, Y);
+		const int32 Slot = ChunkSlots[Chunk];
+		return Slot == INDEX_NONE ? UniformTypes[Chunk] : SlotCells[Slot * CellsPerChunk + LocalIndexOf(X, Y)];
+	}
+
+	/** Write one cell (allocates the chunk if this makes it mixed) */
+	void SetCell(int32 X, int32 Y, EGridCellType CellType);
+#pragma endregion
+
+#pragma region Rect Operations
+	/** Write every cell of the rect; chunks the rect covers entirely are elided instead of written */
+	void FillRect(int32 X, int32 Y, int32 SizeX, int32 SizeY, EGridCellType CellType);
+
+	/** Retype every From cell to To (elided chunks retype in O(1)) @return Number of cells changed */
+	int32 ReplaceType(EGridCellType From, EGridCellType To);
+#pragma endregion
+
+#pragma region Chunk Queries
+	/** True if chunk (CX, CY) is elided; OutType receives its single cell type */
+	bool GetChunkUniformType(int32 ChunkX, int32 ChunkY, EGridCellType& OutType) const;
+
+	/** In-grid cell rect covered by chunk (CX, CY) */
+	void GetChunkBounds(int32 ChunkX, int32 ChunkY, FIntPoint& OutStart, FIntPoint& OutSize) const;
+
+	/** Number of in-grid cells of CellType inside chunk (CX, CY) */
+	int32 CountInChunk(int32 ChunkX, int32 ChunkY, EGridCellType CellType) const;
+#pragma endregion
+
+	/** Expand into a flat row-major array (Index = Y * Width + X) */
+	void CopyTo(TArray<EGridCellType>& OutCells) const;
+
+private:
+	FORCEINLINE int32 ChunkIndexOf(int32 X, int32 Y) const { return (Y >> ChunkShift) * ChunksX + (X >> ChunkShift); }
+	FORCEINLINE int32 LocalIndexOf(int32 X, int32 Y) const { return LocalYOffsets[Y & ChunkMask] | LocalXOffsets[X & ChunkMask]; }
+	FORCEINLINE uint16* CountsOf(int32 Slot) { return SlotTypeCounts.GetData() + Slot * NumCellTypes; }
+	FORCEINLINE const uint16* CountsOf(int32 Slot) const { return SlotTypeCounts.GetData() + Slot * NumCellTypes; }
+
+	/** Number of chunk cells inside the grid (less than CellsPerChunk for edge chunks) */
+	int32 InGridCellsOf(int32 Chunk) const;
+
+	/** Give an elided chunk its own cells, filled with its uniform type @return Slot */
+	int32 AllocateChunk(int32 Chunk);
+
+	/** Drop a chunk's cells and elide it as CellType */
+	void ElideChunk(int32 Chunk, EGridCellType CellType);
+
+	/** Elide an allocated chunk if all its in-grid cells now share one type */
+	void TryElideChunk(int32 Chunk);
+
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EGridMemoryLayout Layout = EGridMemoryLayout::RowMajor;
+
+	/** Per-layout offset tables (LocalIndex = LocalYOffsets[Y & ChunkMask] | LocalXOffsets[X & ChunkMask]) */
+	const uint8* LocalXOffsets = nullptr;
+	const uint8* LocalYOffsets = nullptr;
+
+	int32 ChunksX = 0;
+	int32 ChunksY = 0;
+	int32 NumElided = 0;
+
+	/** Per chunk: the cell type while elided */
+	TArray<EGridCellType> UniformTypes;
+
+	/** Per chunk: slot index, INDEX_NONE while elided */
+	TArray<int32> ChunkSlots;
+
+	/** Slot pool: CellsPerChunk cells and NumCellTypes counts per slot */
+	TArray<EGridCellType> SlotCells;
+	TArray<uint16> SlotTypeCounts;
+	TArray<int32> FreeSlots;
+};
@@ -0,0 +1,93 @@
+// GridConnectivity.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridBitboard.h"
+
+/**
+ * FGridConnectivity - 4-connected components of a room's walkable cells, and which of them are reachable
+ *
+ * Purpose:
+ *   - Forced empty regions can cut the floor into islands no doorway leads to; this finds them on every generation
+ *     instead of in playtests
+ *
+ * Build (scanline labeling, linear in cells):
+ *   - Walkable mask = union of bitboard planes; each row is split into runs of walkable cells (whole words skipped)
+ *   - A run is unioned with every overlapping run of the row below (two-pointer merge, union-find over runs)
+ *   - Components are numbered in row-major order of their first cell
+ *
+ * Reachability:
+ *   - Every component holding a seed cell is reached; the Reachable bitset is then filled run by run
+ *     (the flood fill result, without a per-cell frontier)
+ */
+struct BUILDINGGENERATOR_API FGridConnectivity
+{
+	FGridConnectivity() = default;
+
+	/** Label the cells set in any of WalkablePlanes of Board (clears previous reachability) */
+	void Build(const FGridBitboard& Board, TConstArrayView<int32> WalkablePlanes);
+
+	/** Release storage */
+	void Reset();
+
+	/** Mark the components containing any seed cell and fill the Reachable bitset @return Number of reachable cells */
+	int32 FloodFrom(TConstArrayView<FIntPoint> Seeds);
+
+	FORCEINLINE bool IsBuilt() const { return Masks.IsInitialized(); }
+	FORCEINLINE FIntPoint GetSize() const { return Size; }
+
+#pragma region Queries
+	FORCEINLINE int32 GetNumComponents() const { return ComponentSizes.Num(); }
+	FORCEINLINE int32 GetComponentSize(int32 Component) const { return ComponentSizes[Component]; }
+
+	/** First cell (row-major) of a component */
+	FORCEINLINE FIntPoint GetComponentAnchor(int32 Component) const { return ComponentAnchors[Component]; }
+
+	FORCEINLINE bool IsComponentReached(int32 Component) const { return ComponentReached[Component]; }
+
+	/** Component of a cell, INDEX_NONE if out of bounds or not walkable (binary search over the row's runs) */
+	int32 GetComponent(FIntPoint Cell) const;
+
+	FORCEINLINE bool IsWalkable(FIntPoint Cell) const { return IsInBounds(Cell) && Masks.GetBit(WalkablePlane, Cell.X, Cell.Y); }
+	FORCEINLINE bool IsReachable(FIntPoint Cell) const { return IsInBounds(Cell) && Masks.GetBit(ReachablePlane, Cell.X, Cell.Y); }
+
+	FORCEINLINE int32 GetNumWalkableCells() const { return NumWalkable; }
+	FORCEINLINE int32 GetNumReachableCells() const { return NumReachable; }
+
+	/** Bit planes: walkable mask and reachable set */
+	FORCEINLINE const FGridBitboard& GetMasks() const { return Masks; }
+#pragma endregion
+
+	static constexpr int32 WalkablePlane = 0;
+	static constexpr int32 ReachablePlane = 1;
+
+private:
+	/** Walkable cells [X0, X1) of row Y */
+	struct FRun
+	{
+		int32 Y;
+		int32 X0;
+		int32 X1;
+		int32 Component;
+	};
+
+	FORCEINLINE bool IsInBounds(FIntPoint Cell) const { return Cell.X >= 0 && Cell.Y >= 0 && Cell.X < Size.X && Cell.Y < Size.Y; }
+
+	/** Run holding a walkable cell, INDEX_NONE if none */
+	int32 FindRun(FIntPoint Cell) const;
+
+	FIntPoint Size = FIntPoint::ZeroValue;
+	FGridBitboard Masks;
+
+	/** Runs in row-major order; row Y owns Runs[RowFirstRun[Y] .. RowFirstRun[Y + 1]) */
+	TArray<FRun> Runs;
+	TArray<int32> RowFirstRun;
+
+	TArray<int32> ComponentSizes;
+	TArray<FIntPoint> ComponentAnchors;
+	TArray<bool> ComponentReached;
+
+	int32 NumWalkable = 0;
+	int32 NumReachable = 0;
+};
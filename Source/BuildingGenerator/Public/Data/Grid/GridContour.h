@@ -0,0 +1,116 @@
+// GridContour.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+#include "Data/Grid/GridBitboard.h"
+
+/**
+ * One straight stretch of a mask outline: Length cells in a line whose Side neighbour is outside the mask
+ *   - Side uses grid directions (North = +Y, East = +X, as URoomGenerator::GetNeighborCell)
+ *   - Runs are walked with the mask on the left, so outer outlines go counter-clockwise and holes clockwise
+ */
+struct FGridContourRun
+{
+	ECellDirection Side = ECellDirection::North;
+
+	/** Lowest cell of the run along its axis (X for North/South sides, Y for East/West) */
+	int32 First = 0;
+	int32 Length = 0;
+
+	/** Cell row (North/South sides) or column (East/West sides) the run lies in */
+	int32 Lane = 0;
+
+	FORCEINLINE bool IsAlongX() const { return Side == ECellDirection::North || Side == ECellDirection::South; }
+
+	/** Inside cell at offset I from First */
+	FORCEINLINE FIntPoint GetCell(int32 I) const { return IsAlongX() ? FIntPoint(First + I, Lane) : FIntPoint(Lane, First + I); }
+
+	/** Outside neighbour of the cell at offset I (may lie outside the grid) */
+	FORCEINLINE FIntPoint GetOutsideCell(int32 I) const
+	{
+		const FIntPoint Cell = GetCell(I);
+		switch (Side)
+		{
+		case ECellDirection::North:	return FIntPoint(Cell.X, Cell.Y + 1);
+		case ECellDirection::East:	return FIntPoint(Cell.X + 1, Cell.Y);
+		case ECellDirection::South:	return FIntPoint(Cell.X, Cell.Y - 1);
+		default:					return FIntPoint(Cell.X - 1, Cell.Y);
+		}
+	}
+
+	/** Lattice line the boundary lies on (a Y line for North/South sides, an X line for East/West) */
+	FORCEINLINE int32 GetLine() const { return (Side == ECellDirection::North || Side == ECellDirection::East) ? Lane + 1 : Lane; }
+
+	/** Lattice vertices where the walk starts and ends (cell (X, Y) spans [X, X + 1] x [Y, Y + 1]) */
+	FIntPoint GetStartVertex() const;
+	FIntPoint GetEndVertex() const;
+};
+
+/**
+ * Outline vertex where one run ends and the next begins
+ *   - Convex (the walk turns left): one inside cell touches the vertex, an ExternalCorner/DeadEnd cell of the mask
+ *   - Concave (the walk turns right): three inside cells touch it, the one opposite the outside cell is InternalCorner
+ */
+struct FGridContourCorner
+{
+	FIntPoint Vertex = FIntPoint::ZeroValue;
+
+	/** Sides of the run ending here and of the run starting here (always perpendicular) */
+	ECellDirection InSide = ECellDirection::North;
+	ECellDirection OutSide = ECellDirection::East;
+
+	bool bConvex = true;
+
+	/** The two sides split by axis: the East/West one and the North/South one */
+	FORCEINLINE ECellDirection GetSideAlongY() const { return (InSide == ECellDirection::East || InSide == ECellDirection::West) ? InSide : OutSide; }
+	FORCEINLINE ECellDirection GetSideAlongX() const { return (InSide == ECellDirection::East || InSide == ECellDirection::West) ? OutSide : InSide; }
+};
+
+/**
+ * FGridContour - Ordered outline runs of one bitboard plane (walls along arbitrary room shapes)
+ *
+ * Trace (linear):
+ *   - One row sweep: North/South runs are the bit runs of In & ~InAbove / In & ~InBelow; East/West runs
+ *     come from In & ~(In shifted by one) and are closed when their column bit drops out (per-column start rows)
+ *   - Runs are then chained end vertex to start vertex into closed loops (hash of start vertices);
+ *     where two cells touch only diagonally the walk turns left, so diagonal cells get separate outlines
+ *   - Loop winding (shoelace area) tells outer outlines from holes such as courtyards
+ *   - The chaining pass also records a corner at every run end (left turn = convex, right turn = concave)
+ */
+struct BUILDINGGENERATOR_API FGridContour
+{
+	FGridContour() = default;
+
+	/** Trace every outline of the cells set in Plane of Mask */
+	void Trace(const FGridBitboard& Mask, int32 Plane);
+
+	/** Release storage */
+	void Reset();
+
+	/** Runs loop by loop, each loop in walk order */
+	FORCEINLINE TConstArrayView<FGridContourRun> GetRuns() const { return Runs; }
+
+	FORCEINLINE int32 GetNumLoops() const { return LoopIsOuter.Num(); }
+
+	FORCEINLINE TConstArrayView<FGridContourRun> GetLoopRuns(int32 Loop) const
+	{
+		return TConstArrayView<FGridContourRun>(Runs.GetData() + LoopStarts[Loop], LoopStarts[Loop + 1] - LoopStarts[Loop]);
+	}
+
+	/** Corner at the end of each run (Corners[i] joins Runs[i] to the next run of its loop) */
+	FORCEINLINE TConstArrayView<FGridContourCorner> GetCorners() const { return Corners; }
+
+	/** True for an outer outline (counter-clockwise), false for a hole */
+	FORCEINLINE bool IsOuterLoop(int32 Loop) const { return LoopIsOuter[Loop]; }
+
+	/** Total boundary length in cells */
+	int32 GetPerimeter() const;
+
+private:
+	TArray<FGridContourRun> Runs;
+	TArray<FGridContourCorner> Corners;
+	TArray<int32> LoopStarts;
+	TArray<bool> LoopIsOuter;
+};
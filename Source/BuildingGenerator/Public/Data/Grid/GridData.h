@@ -32,7 +32,7 @@ enum class ECellZone : uint8
 	/** Cell is on the border (3 neighbors) */
 	Border UMETA(DisplayName = "Border"),
 	
-	/** Cell is a corner (2 adjacent neighbors) */
+	/** Cell is a corner (2 adjacent neighbors; AnalyzeTopology reports External/InternalCorner instead) */
 	Corner UMETA(DisplayName = "Corner"),
 	
 	/** Cell is an external corner (convex corner) */
@@ -44,7 +44,7 @@ enum class ECellZone : uint8
 	/** Cell is a doorway/connection point */
 	Door UMETA(DisplayName = "Door"),
 	
-	/** Cell is a dead-end (1 neighbor only) */
+	/** Cell is a dead-end (1 neighbor or none) */
 	DeadEnd UMETA(DisplayName = "Dead End")
 };
 
@@ -62,6 +62,20 @@ enum class EGridCellType : uint8
 	ECT_Void        UMETA(DisplayName = "Void Cell"),
 };
 
+// Order of cells inside a 16x16 storage chunk (all layouts expose the same X/Y API)
+UENUM(BlueprintType)
+enum class EGridMemoryLayout : uint8
+{
+	/** Rows of 16 cells, one after another */
+	RowMajor 	UMETA(DisplayName = "Row Major"),
+
+	/** 4x4 tiles stored contiguously (a 4x4 footprint aligned to the tile is one 16-byte run) */
+	Tiled4x4 	UMETA(DisplayName = "Tiled 4x4"),
+
+	/** Z-order curve (interleaved X/Y bits, neighbours in both axes stay close) */
+	Morton 		UMETA(DisplayName = "Morton (Z-Order)"),
+};
+
 //========================================================================
 // CELL DATA STRUCTURE (Phase 2 - Rich Topology Data)
 //========================================================================
@@ -75,14 +89,15 @@ enum class EGridCellType : uint8
  *   - Enables zone-based content spawning (spawn torches only on borders)
  * 
  * Usage:
- *   - Stored in TMap<FIntPoint, FCellData> CellMetadata in URoomGenerator
+ *   - Blueprint façade: URoomGenerator stores topology densely in FGridTopologyStore CellTopology
+ *     and builds FCellData on demand (GetCellData / GetCellMetadata)
  *   - Populated by AnalyzeTopology() after grid creation
  *   - Queried by spawning systems for zone-based placement
  * 
  * Relationship to GridState:
  *   - GridState (TArray) = flat occupancy data (Empty, Custom, FloorMesh, etc.)
- *   - CellMetadata (TMap) = rich topology data (zone, walls, neighbors)
- *   - Both coexist - GridState for generation, CellMetadata for queries
+ *   - CellTopology (SoA, indexed like GridState) = zone byte, wall mask, opening mask
+ *   - Both coexist - GridState for generation, CellTopology for queries
  */
 USTRUCT(BlueprintType)
 struct BUILDINGGENERATOR_API FCellData
@@ -117,6 +132,10 @@ struct BUILDINGGENERATOR_API FCellData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cell Data|Topology")
 	TSet<ECellDirection> OpenDirections;
 
+	/** Steps to the nearest wall (1 = next to a wall, saturates at 255) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cell Data|Topology")
+	int32 DistanceToWall;
+
 	//========================================================================
 	// CONSTRUCTORS
 	//========================================================================
@@ -126,6 +145,7 @@ struct BUILDINGGENERATOR_API FCellData
 		: Coordinates(FIntPoint::ZeroValue)
 		, CellZone(ECellZone::Empty)
 		, bIsOccupied(false)
+		, DistanceToWall(0)
 	{
 	}
 
@@ -134,6 +154,7 @@ struct BUILDINGGENERATOR_API FCellData
 		: Coordinates(InCoords)
 		, CellZone(ECellZone:: Center)
 		, bIsOccupied(true)
+		, DistanceToWall(0)
 	{
 	}
 
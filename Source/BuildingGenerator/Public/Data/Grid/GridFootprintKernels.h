@@ -0,0 +1,135 @@
+﻿// GridFootprintKernels.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/IntegerSequence.h"
+#include "Data/Grid/GridBitboard.h"
+
+/**
+ * TGridFootprintKernel - Bitboard rect tests and writes specialized for one compile-time WxH footprint
+ *
+ * Purpose:
+ *   - The floor/ceiling footprint ladder (4x4, 2x4, 4x2, 2x2, 1x4, 4x1, 1x2, 2x1, 1x1) is fixed, so the row mask and row
+ *     count are constants: every test is H unrolled row reads combined without branches, every write is H unrolled masked stores
+ *
+ * Like FGridBitboard's rect functions, callers pass a footprint already validated against the grid bounds
+ */
+template<int32 W, int32 H>
+struct TGridFootprintKernel
+{
+	static_assert(W >= 1 && W <= 64 && H >= 1, "Footprint kernels cover 1..64 cells per row");
+
+	/** W low bits set */
+	static constexpr uint64 RowMask = (W == 64) ? ~0ull : ((1ull << W) - 1ull);
+
+	/** Bits [X, X + W) of a row as the low W bits (the span may straddle two words) */
+	static FORCEINLINE uint64 ReadSpan(const uint64* Row, int32 X)
+	{
+		const int32 Bit = X & 63;
+		const uint64* Word = Row + (X >> 6);
+		uint64 Bits = Word[0] >> Bit;
+		if (Bit + W > 64) { Bits |= Word[1] << (64 - Bit); }
+		return Bits & RowMask;
+	}
+
+	/** Set or clear bits [X, X + W) of a row */
+	static FORCEINLINE void WriteSpan(uint64* Row, int32 X, bool bValue)
+	{
+		const int32 Bit = X & 63;
+		uint64* Word = Row + (X >> 6);
+		const uint64 LoMask = RowMask << Bit;
+		Word[0] = bValue ? (Word[0] | LoMask) : (Word[0] & ~LoMask);
+		if (Bit + W > 64)
+		{
+			const uint64 HiMask = RowMask >> (64 - Bit);
+			Word[1] = bValue ? (Word[1] | HiMask) : (Word[1] & ~HiMask);
+		}
+	}
+
+	/** True if every cell of the footprint at (X, Y) is set in Plane */
+	static bool IsSet(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y)
+	{
+		return AndRows(Board, Plane, X, Y, TMakeIntegerSequence<int32, H>()) == RowMask;
+	}
+
+	/** True if no cell of the footprint at (X, Y) is set in Plane */
+	static bool IsClear(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y)
+	{
+		return OrRows(Board, Plane, X, Y, TMakeIntegerSequence<int32, H>()) == 0;
+	}
+
+	/** Set or clear the footprint at (X, Y) in Plane */
+	static void SetRect(FGridBitboard& Board, int32 Plane, int32 X, int32 Y, bool bValue)
+	{
+		WriteRows(Board, Plane, X, Y, bValue, TMakeIntegerSequence<int32, H>());
+	}
+
+	/** Move the footprint from FromPlane to ToPlane (footprint must be all FromPlane) */
+	static void Retype(FGridBitboard& Board, int32 FromPlane, int32 ToPlane, int32 X, int32 Y)
+	{
+		RetypeRows(Board, FromPlane, ToPlane, X, Y, TMakeIntegerSequence<int32, H>());
+	}
+
+private:
+	template<int32... Rows>
+	static FORCEINLINE uint64 AndRows(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y, TIntegerSequence<int32, Rows...>)
+	{
+		return (RowMask & ... & ReadSpan(Board.GetRow(Plane, Y + Rows), X));
+	}
+
+	template<int32... Rows>
+	static FORCEINLINE uint64 OrRows(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y, TIntegerSequence<int32, Rows...>)
+	{
+		return (0ull | ... | ReadSpan(Board.GetRow(Plane, Y + Rows), X));
+	}
+
+	template<int32... Rows>
+	static FORCEINLINE void WriteRows(FGridBitboard& Board, int32 Plane, int32 X, int32 Y, bool bValue, TIntegerSequence<int32, Rows...>)
+	{
+		(WriteSpan(Board.GetRow(Plane, Y + Rows), X, bValue), ...);
+	}
+
+	template<int32... Rows>
+	static FORCEINLINE void RetypeRows(FGridBitboard& Board, int32 FromPlane, int32 ToPlane, int32 X, int32 Y, TIntegerSequence<int32, Rows...>)
+	{
+		(WriteSpan(Board.GetRow(FromPlane, Y + Rows), X, false), ...);
+		(WriteSpan(Board.GetRow(ToPlane, Y + Rows), X, true), ...);
+	}
+};
+
+/**
+ * FGridFootprintKernel - Type-erased entry of the footprint kernel dispatch table
+ *
+ * Find() maps a runtime footprint onto its TGridFootprintKernel instantiation with one table index;
+ * footprints outside 1..MaxExtent on either axis return nullptr and callers take their generic rect path
+ */
+struct BUILDINGGENERATOR_API FGridFootprintKernel
+{
+	/** Largest specialized width/height (covers the whole ladder plus 3-cell edge remainders) */
+	static constexpr int32 MaxExtent = 4;
+
+	bool (*IsSet)(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y);
+	bool (*IsClear)(const FGridBitboard& Board, int32 Plane, int32 X, int32 Y);
+	void (*SetRect)(FGridBitboard& Board, int32 Plane, int32 X, int32 Y, bool bValue);
+	void (*Retype)(FGridBitboard& Board, int32 FromPlane, int32 ToPlane, int32 X, int32 Y);
+
+	template<int32 W, int32 H>
+	static constexpr FGridFootprintKernel Make()
+	{
+		using KernelType = TGridFootprintKernel<W, H>;
+		return { &KernelType::IsSet, &KernelType::IsClear, &KernelType::SetRect, &KernelType::Retype };
+	}
+
+	/** Kernel for a footprint, or nullptr for non-standard sizes */
+	static FORCEINLINE const FGridFootprintKernel* Find(FIntPoint Size)
+	{
+		const uint32 Col = static_cast<uint32>(Size.X - 1);
+		const uint32 Row = static_cast<uint32>(Size.Y - 1);
+		return (Col < MaxExtent && Row < MaxExtent) ? &Table[Row][Col] : nullptr;
+	}
+
+private:
+	/** Table[H - 1][W - 1] (defined in GridFootprintKernels.cpp) */
+	static const FGridFootprintKernel Table[MaxExtent][MaxExtent];
+};
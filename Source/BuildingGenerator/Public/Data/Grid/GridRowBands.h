@@ -0,0 +1,58 @@
+// GridRowBands.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+/**
+ * Row-band splitting for grid passes run with ParallelFor
+ *   - A band is a contiguous row range, so per-row outputs of different bands never overlap
+ *   - Per-band partial results (counts, histograms) are stored by band index and reduced by the caller
+ *   - Grids under MinParallelCells stay on the calling thread: dispatch costs more than the pass
+ *     (BenchmarkParallelTopology shows the crossover)
+ *   - Word-at-a-time passes (plane popcounts) stay serial: a plane of a clamped room is a few dozen words
+ */
+namespace GridRowBands
+{
+	static constexpr int32 MinParallelCells = 8192;
+	static constexpr int32 MinRowsPerBand = 8;
+
+	/** One band per worker plus the calling thread, at least MinRowsPerBand rows each (capped by MaxBands if > 0) */
+	inline int32 GetNumBandsForRows(int32 NumRows, int32 MaxBands = 0)
+	{
+		int32 NumBands = FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, NumRows / MinRowsPerBand);
+		if (MaxBands > 0) { NumBands = FMath::Min(NumBands, MaxBands); }
+		return FMath::Max(NumBands, 1);
+	}
+
+	/** Bands for a per-cell pass over a grid: 1 under MinParallelCells */
+	inline int32 GetNumBands(FIntPoint Size, int32 MaxBands = 0)
+	{
+		return Size.X * Size.Y < MinParallelCells ? 1 : GetNumBandsForRows(Size.Y, MaxBands);
+	}
+
+	/** Rows [OutFirst, OutEnd) of Band (band heights differ by at most one row) */
+	FORCEINLINE void GetBandRows(int32 Band, int32 NumBands, int32 NumRows, int32& OutFirst, int32& OutEnd)
+	{
+		OutFirst = static_cast<int32>(static_cast<int64>(NumRows) * Band / NumBands);
+		OutEnd = static_cast<int32>(static_cast<int64>(NumRows) * (Band + 1) / NumBands);
+	}
+
+	/** Body(Band, FirstRow, EndRow) for every band, across task threads when NumBands > 1 */
+	template<typename BodyType>
+	void ForEachBand(int32 NumRows, int32 NumBands, BodyType&& Body)
+	{
+		NumBands = FMath::Clamp(NumBands, 1, FMath::Max(NumRows, 1));
+		auto RunBand = [&Body, NumBands, NumRows](int32 Band)
+		{
+			int32 FirstRow, EndRow;
+			GetBandRows(Band, NumBands, NumRows, FirstRow, EndRow);
+			Body(Band, FirstRow, EndRow);
+		};
+
+		if (NumBands == 1) { RunBand(0); return; }
+		ParallelFor(NumBands, RunBand);
+	}
+}
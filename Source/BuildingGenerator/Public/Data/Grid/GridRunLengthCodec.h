@@ -0,0 +1,110 @@
+// GridRunLengthCodec.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+
+/**
+ * Room grid run-length encoding - compact form of a grid's cell types (and optionally zones) for save and transfer
+ *
+ * Format (all integers LEB128 varints):
+ *   - Header: FormatVersion byte, Flags byte (bit 0 = zones present), Width, Height
+ *   - Runs in row-major order until Width * Height cells are covered, one symbol byte each:
+ *       bits 0-2  cell type, or CopyAboveType for "same cells as the row above" (rows after the first)
+ *       bits 3-5  zone (0 without zones or for copy runs)
+ *       bits 6-7  run length 1..3, 0 = varint (Length - MinVarintRun) follows
+ *   - Runs may span rows; copy runs make rows repeated from the row above (walls down the sides of a room) nearly free
+ *
+ * A uniform 50x50 room is 7 bytes, a walled 50x50 room 13; every cell change against both the previous
+ * cell and the cell above costs one to three bytes
+ */
+namespace GridRunLength
+{
+	static constexpr uint8 FormatVersion = 1;
+	static constexpr uint8 FlagHasZones = 1 << 0;
+
+	/** Cell type bits marking a copy-above run */
+	static constexpr uint8 CopyAboveType = 7;
+
+	/** Smallest run length that needs a varint after the symbol byte */
+	static constexpr int32 MinVarintRun = 4;
+
+	/** Largest grid a stream may declare (checked before the decoder allocates; a few bytes can claim any size) */
+	static constexpr int32 MaxDimension = 16384;
+	static constexpr int64 MaxCells = 1 << 24;
+}
+
+/* FGridRunLengthEncoder - Streaming encoder: construct, Push every cell in row-major order, then Finish */
+struct BUILDINGGENERATOR_API FGridRunLengthEncoder
+{
+	/** Start a stream appended to OutBytes (must outlive the encoder) */
+	FGridRunLengthEncoder(TArray<uint8>& OutBytes, FIntPoint InGridSize, bool bInHasZones);
+
+	/** Append Count cells of one type/zone (zone is ignored without zones) */
+	void Push(EGridCellType CellType, ECellZone Zone = ECellZone::Empty, int32 Count = 1);
+
+	/** Flush the pending run @return False unless exactly Width * Height cells were pushed */
+	bool Finish();
+
+private:
+	void FlushRun();
+	void WriteVarint(uint32 Value);
+
+	TArray<uint8>& Bytes;
+	int32 Width;
+	int64 TotalCells;
+	int64 PushedCells = 0;
+	bool bHasZones;
+
+	/** Symbols of the previous and current row, X = column of the next cell */
+	TArray<uint8> PrevRow;
+	TArray<uint8> CurRow;
+	int32 X = 0;
+	bool bHasPrevRow = false;
+
+	bool bRunIsCopy = false;
+	uint8 RunSymbol = 0;
+	int32 RunLength = 0;
+};
+
+/* FGridRunLengthDecoder - Streaming decoder: ReadHeader, then NextRun until it returns false */
+struct BUILDINGGENERATOR_API FGridRunLengthDecoder
+{
+	explicit FGridRunLengthDecoder(TConstArrayView<uint8> InBytes) : Bytes(InBytes) {}
+
+	/** Parse the header @return False on an unknown version, a truncated header or a size beyond MaxDimension / MaxCells */
+	bool ReadHeader();
+
+	FORCEINLINE FIntPoint GetGridSize() const { return GridSize; }
+	FORCEINLINE bool HasZones() const { return bHasZones; }
+
+	/** True once every cell was decoded without error */
+	FORCEINLINE bool IsComplete() const { return !bError && bHeaderRead && RemainingCells == 0 && PendingCopy == 0; }
+
+	/** Next run of identical cells (copy runs come out split at value changes and row ends) @return False at the end or on malformed data (check IsComplete) */
+	bool NextRun(EGridCellType& OutCellType, ECellZone& OutZone, int32& OutCount);
+
+	/** Decode a whole stream into flat row-major arrays (OutZones left empty without zones) */
+	static bool DecodeAll(TConstArrayView<uint8> InBytes, FIntPoint& OutGridSize, TArray<EGridCellType>& OutCells, TArray<ECellZone>& OutZones);
+
+private:
+	bool ReadVarint(uint32& OutValue);
+
+	/** Record Count cells of Symbol in the row buffers */
+	void Emit(uint8 Symbol, int32 Count);
+
+	TConstArrayView<uint8> Bytes;
+	int32 Offset = 0;
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	int64 RemainingCells = 0;
+	int32 PendingCopy = 0;
+	bool bHasZones = false;
+	bool bHeaderRead = false;
+	bool bError = false;
+
+	TArray<uint8> PrevRow;
+	TArray<uint8> CurRow;
+	int32 X = 0;
+	bool bHasPrevRow = false;
+};
@@ -0,0 +1,207 @@
+// GridTopologyStore.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+
+struct FGridBitboard;
+
+/* Direction bits of the wall/opening masks (bit = 1 << ECellDirection) */
+namespace GridDirectionMask
+{
+	static constexpr uint8 North = 1 << static_cast<uint8>(ECellDirection::North);
+	static constexpr uint8 East = 1 << static_cast<uint8>(ECellDirection::East);
+	static constexpr uint8 South = 1 << static_cast<uint8>(ECellDirection::South);
+	static constexpr uint8 West = 1 << static_cast<uint8>(ECellDirection::West);
+	static constexpr uint8 All = North | East | South | West;
+
+	FORCEINLINE constexpr uint8 Of(ECellDirection Direction) { return static_cast<uint8>(1 << static_cast<uint8>(Direction)); }
+	FORCEINLINE int32 Count(uint8 Mask) { return FMath::CountBits(static_cast<uint64>(Mask & All)); }
+
+	/** Expand a mask into a direction set (Blueprint façade only) */
+	BUILDINGGENERATOR_API void ToDirectionSet(uint8 Mask, TSet<ECellDirection>& OutDirections);
+}
+
+/**
+ * FGridTopologyStore - Dense struct-of-arrays topology for a room grid
+ *
+ * Purpose:
+ *   - Replaces TMap<FIntPoint, FCellData>, where every cell paid for a map entry and two heap-allocated TSets
+ *   - Three bytes per grid cell; zone scans are linear loops over one byte array
+ *
+ * Layout:
+ *   - Indexed like GridState (Index = Y * Width + X)
+ *   - Zones: ECellZone, Empty for cells that were not analyzed (unoccupied)
+ *   - WallMasks / OpenMasks: GridDirectionMask bits
+ *   - WallDistances: city-block steps to the nearest non-walkable cell (GridWalkable) or the grid edge (0 on those cells,
+ *     1 on cells with a wall, saturating at MaxWallDistance)
+ *   - Zone index: analyzed cells grouped by zone (row-major within a zone) plus a border list,
+ *     built once per analysis by BuildZoneIndex so queries return views and counts without allocating;
+ *     per-cell slots into both lists let UpdateCells patch them in place after local edits
+ *
+ * Filled a row band at a time by AnalyzeRows (bit-parallel over FGridBitboard rows, 64 cells per word op)
+ * or a dirty rect at a time by UpdateCells
+ * FCellData is still available per cell as a Blueprint façade (MakeCellData)
+ */
+struct BUILDINGGENERATOR_API FGridTopologyStore
+{
+	static constexpr int32 NumZones = static_cast<int32>(ECellZone::DeadEnd) + 1;
+	static constexpr uint8 MaxWallDistance = MAX_uint8;
+
+	FGridTopologyStore() = default;
+
+	/** Size the store for InSize cells, all unanalyzed */
+	void Init(FIntPoint InSize);
+
+	/** Release all storage */
+	void Reset();
+
+	FORCEINLINE bool IsInitialized() const { return Zones.Num() > 0; }
+	FORCEINLINE FIntPoint GetSize() const { return Size; }
+	FORCEINLINE int32 Num() const { return Zones.Num(); }
+	FORCEINLINE bool IsValidCell(FIntPoint Cell) const { return Cell.X >= 0 && Cell.Y >= 0 && Cell.X < Size.X && Cell.Y < Size.Y; }
+	FORCEINLINE int32 IndexOf(FIntPoint Cell) const { return Cell.Y * Size.X + Cell.X; }
+	FORCEINLINE FIntPoint CellOf(int32 Index) const { return FIntPoint(Index % Size.X, Index / Size.X); }
+
+	/** Bytes held by the store */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Zones.GetAllocatedSize() + WallMasks.GetAllocatedSize() + OpenMasks.GetAllocatedSize()
+			+ WallDistances.GetAllocatedSize() + ZoneCells.GetAllocatedSize() + BorderCells.GetAllocatedSize()
+			+ ZoneSlots.GetAllocatedSize() + BorderSlots.GetAllocatedSize();
+	}
+
+#pragma region Cell Access
+	FORCEINLINE bool IsAnalyzed(int32 Index) const { return Zones[Index] != ECellZone::Empty; }
+	FORCEINLINE ECellZone GetZone(int32 Index) const { return Zones[Index]; }
+	FORCEINLINE uint8 GetWallMask(int32 Index) const { return WallMasks[Index]; }
+	FORCEINLINE uint8 GetOpenMask(int32 Index) const { return OpenMasks[Index]; }
+	FORCEINLINE uint8 GetWallDistance(int32 Index) const { return WallDistances[Index]; }
+
+	FORCEINLINE void SetCell(int32 Index, ECellZone Zone, uint8 WallMask, uint8 OpenMask = 0)
+	{
+		Zones[Index] = Zone;
+		WallMasks[Index] = WallMask;
+		OpenMasks[Index] = OpenMask;
+		bZoneIndexStale = true;
+	}
+
+	/** Build the FCellData façade for a cell (default FCellData when out of bounds or unanalyzed) */
+	FCellData MakeCellData(FIntPoint Cell) const;
+
+	/** Raw per-cell arrays (row-major) */
+	FORCEINLINE TConstArrayView<ECellZone> GetZones() const { return Zones; }
+	FORCEINLINE TConstArrayView<uint8> GetWallMasks() const { return WallMasks; }
+	FORCEINLINE TConstArrayView<uint8> GetOpenMasks() const { return OpenMasks; }
+	FORCEINLINE TConstArrayView<uint8> GetWallDistances() const { return WallDistances; }
+#pragma endregion
+
+#pragma region Analysis
+	/**
+	 * Classify rows [FirstRow, FirstRow + NumRows) from a room bitboard of the same size
+	 *   - Analyzed cells: FloorMesh or Custom; open neighbours: GridWalkable types (WallMesh cut-outs, Empty, Void and out of bounds = wall)
+	 *   - Neighbour presence for a whole row word comes from shifted neighbour-row words; zones are one
+	 *     GridZoneTable read per boundary cell, and fully surrounded words are filled as Center in bulk
+	 *   - Rewrites zones and wall masks of the band (opening masks are kept); rows only read the band's
+	 *     neighbours, so disjoint bands can run concurrently
+	 *   - Leaves the zone index stale until BuildZoneIndex
+	 * @return Number of analyzed cells in the band
+	 */
+	int32 AnalyzeRows(const FGridBitboard& Board, int32 FirstRow, int32 NumRows);
+
+	/** AnalyzeRows over the whole grid split into NumBands row bands run with ParallelFor (per-band counts reduced) @return Analyzed cells */
+	int32 AnalyzeAllRows(const FGridBitboard& Board, int32 NumBands);
+
+	/**
+	 * Distance-to-wall field from a room bitboard of the same size (two-pass city-block chamfer, linear)
+	 *   - Sources are non-walkable cells (forced-empty WallMesh cut-outs included) and the outside of the grid,
+	 *     matching the wall masks of AnalyzeRows
+	 */
+	void BuildWallDistances(const FGridBitboard& Board);
+
+	/**
+	 * Bring wall distances up to date after the board changed only inside DirtyRect (Min inclusive, Max exclusive)
+	 *   - A changed distance has its old or new nearest source in DirtyRect, no farther than the old largest distance,
+	 *     so only DirtyRect grown by that bound is swept; neighbours outside the window seed it with their kept values
+	 * @return Number of cells swept
+	 */
+	int32 UpdateWallDistances(const FGridBitboard& Board, const FIntRect& DirtyRect);
+
+	/**
+	 * Re-classify the cells of DirtyRect (Min inclusive, Max exclusive) and their 8-neighbour ring after a local edit
+	 *   - Same rules as AnalyzeRows, one GridZoneTable read per ring cell; cells outside the ring are untouched
+	 *   - A built zone index is patched in place (a changed cell moves between zone buckets in O(NumZones)),
+	 *     so counts and views stay current without BuildZoneIndex; a stale index is left stale
+	 *   - Wall distances are not updated (one edit can move them up to MaxWallDistance cells away: BuildWallDistances)
+	 * @return Number of cells whose zone or wall mask changed
+	 */
+	int32 UpdateCells(const FGridBitboard& Board, const FIntRect& DirtyRect);
+
+	/**
+	 * Regroup analyzed cells by zone (counting sort, two linear passes)
+	 *   - With NumBands > 1 both passes run per row band: per-band zone histograms are reduced into each band's
+	 *     first slot per zone, so bands scatter into disjoint ranges and the result matches the serial build
+	 */
+	void BuildZoneIndex(int32 NumBands = 1);
+
+	FORCEINLINE bool IsZoneIndexBuilt() const { return !bZoneIndexStale; }
+#pragma endregion
+
+#pragma region Zone Queries
+	/** Cells of Zone, row-major until UpdateCells moves some (empty for ECellZone::Empty: unanalyzed cells are not indexed) */
+	FORCEINLINE TConstArrayView<FIntPoint> GetZoneCells(ECellZone Zone) const { return GetZoneCells(Zone, Zone); }
+
+	/** Cells of every zone in [First, Last] in enum order (zones are stored contiguously) */
+	FORCEINLINE TConstArrayView<FIntPoint> GetZoneCells(ECellZone First, ECellZone Last) const
+	{
+		checkSlow(!bZoneIndexStale && First <= Last);
+		const int32 Start = ZoneStarts[static_cast<int32>(First)];
+		return TConstArrayView<FIntPoint>(ZoneCells.GetData() + Start, ZoneStarts[static_cast<int32>(Last) + 1] - Start);
+	}
+
+	FORCEINLINE int32 GetZoneCount(ECellZone Zone) const { return GetZoneCells(Zone).Num(); }
+
+	/** Analyzed cells with at least one wall, row-major until UpdateCells moves some */
+	FORCEINLINE TConstArrayView<FIntPoint> GetBorderCells() const { checkSlow(!bZoneIndexStale); return BorderCells; }
+
+	/** Number of analyzed cells */
+	FORCEINLINE int32 GetNumAnalyzed() const { checkSlow(!bZoneIndexStale); return ZoneCells.Num(); }
+
+	/** Append analyzed cells whose wall distance is in [MinDistance, MaxDistance], row-major (one pass over two byte arrays) */
+	void GetCellsByWallDistance(int32 MinDistance, int32 MaxDistance, TArray<FIntPoint>& OutCells) const;
+#pragma endregion
+
+private:
+	/** AnalyzeRows body for rows [FirstRow, EndRow): writes only those rows, so bands can run concurrently */
+	int32 AnalyzeBand(const FGridBitboard& Board, int32 FirstRow, int32 EndRow);
+
+	/** Two-pass chamfer over Window (reading the kept values just outside it) @return Largest distance written */
+	uint8 BuildWallDistancesInRect(const FGridBitboard& Board, const FIntRect& Window);
+
+	/** In-place zone index patches (slots of moved cells are kept current) */
+	void AddToZoneIndex(int32 Index, ECellZone Zone);
+	void RemoveFromZoneIndex(int32 Index, ECellZone Zone);
+	void AddToBorderCells(int32 Index);
+	void RemoveFromBorderCells(int32 Index);
+
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	TArray<ECellZone> Zones;
+	TArray<uint8> WallMasks;
+	TArray<uint8> OpenMasks;
+	TArray<uint8> WallDistances;
+
+	/** Upper bound of WallDistances (exact after BuildWallDistances), the reach of an edit for UpdateWallDistances */
+	uint8 WallDistanceBound = 0;
+
+	/** Zone index: ZoneCells[ZoneStarts[Z] .. ZoneStarts[Z + 1]) are the cells of zone Z */
+	TArray<FIntPoint> ZoneCells;
+	TArray<FIntPoint> BorderCells;
+	int32 ZoneStarts[NumZones + 1] = {};
+
+	/** Position of each cell in ZoneCells / BorderCells, INDEX_NONE when not listed */
+	TArray<int32> ZoneSlots;
+	TArray<int32> BorderSlots;
+	bool bZoneIndexStale = false;
+};
@@ -0,0 +1,80 @@
+// GridZoneTable.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+#include "Data/Grid/GridTopologyStore.h"
+
+/**
+ * 8-neighbour occupancy byte (bit set = neighbour is inside the grid and GridWalkable)
+ *   - Cardinal bits share GridDirectionMask's layout, so the wall mask is the inverted low nibble
+ *   - Diagonal bits sit between their two cardinals (NE between N and E, ...)
+ */
+namespace GridNeighborMask
+{
+	static constexpr uint8 North = GridDirectionMask::North;
+	static constexpr uint8 East = GridDirectionMask::East;
+	static constexpr uint8 South = GridDirectionMask::South;
+	static constexpr uint8 West = GridDirectionMask::West;
+	static constexpr uint8 NorthEast = 1 << 4;
+	static constexpr uint8 SouthEast = 1 << 5;
+	static constexpr uint8 SouthWest = 1 << 6;
+	static constexpr uint8 NorthWest = 1 << 7;
+	static constexpr uint8 Cardinals = GridDirectionMask::All;
+
+	/** Neighbour offsets by bit index (North = +Y, matching URoomGenerator::GetNeighborCell) */
+	static constexpr int32 OffsetX[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	static constexpr int32 OffsetY[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+
+	/** Cardinal directions without an open neighbour */
+	FORCEINLINE constexpr uint8 WallsOf(uint8 Neighbors) { return static_cast<uint8>(~Neighbors & Cardinals); }
+}
+
+namespace GridZoneTable
+{
+	/**
+	 * Zone of an occupied cell from its 8-neighbour occupancy byte
+	 *   - 3 or 4 walls: DeadEnd
+	 *   - 2 adjacent walls: ExternalCorner (convex); 2 opposite walls: Border (corridor)
+	 *   - 1 wall: Border
+	 *   - No walls but an open diagonal missing: InternalCorner (concave, e.g. the inner cell of an L)
+	 *   - Otherwise Center
+	 */
+	constexpr ECellZone Classify(uint8 Neighbors)
+	{
+		const uint8 Walls = GridNeighborMask::WallsOf(Neighbors);
+		const int32 WallCount = (Walls & 1) + ((Walls >> 1) & 1) + ((Walls >> 2) & 1) + ((Walls >> 3) & 1);
+
+		if (WallCount >= 3) return ECellZone::DeadEnd;
+		if (WallCount == 2)
+		{
+			const bool bOpposite = Walls == (GridNeighborMask::North | GridNeighborMask::South) ||
+				Walls == (GridNeighborMask::East | GridNeighborMask::West);
+			return bOpposite ? ECellZone::Border : ECellZone::ExternalCorner;
+		}
+		if (WallCount == 1) return ECellZone::Border;
+		return (Neighbors & 0xF0) != 0xF0 ? ECellZone::InternalCorner : ECellZone::Center;
+	}
+
+	struct FTable
+	{
+		ECellZone Zones[256];
+
+		constexpr FTable() : Zones()
+		{
+			for (int32 Neighbors = 0; Neighbors < 256; ++Neighbors) { Zones[Neighbors] = Classify(static_cast<uint8>(Neighbors)); }
+		}
+	};
+
+	inline constexpr FTable Table;
+
+	/** One table read per cell */
+	FORCEINLINE ECellZone Lookup(uint8 Neighbors) { return Table.Zones[Neighbors]; }
+
+	static_assert(Table.Zones[0xFF] == ECellZone::Center, "Fully surrounded cell must be Center");
+	static_assert(Table.Zones[0xFF & ~GridNeighborMask::NorthEast] == ECellZone::InternalCorner, "Missing diagonal must be InternalCorner");
+	static_assert(Table.Zones[GridNeighborMask::South | GridNeighborMask::West | GridNeighborMask::SouthWest] == ECellZone::ExternalCorner, "N+E walls must be ExternalCorner");
+	static_assert(Table.Zones[GridNeighborMask::East | GridNeighborMask::West] == ECellZone::Border, "Corridor must be Border");
+	static_assert(Table.Zones[0] == ECellZone::DeadEnd, "Isolated cell must be DeadEnd");
+}
@@ -0,0 +1,72 @@
+// RoomGridSnapshot.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+
+struct FRoomGridSnapshot;
+
+/* Shared handle readers hold on to (safe to copy and release from any thread) */
+using FRoomGridSnapshotPtr = TSharedPtr<const FRoomGridSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * FRoomGridSnapshot - Immutable copy of a room grid's occupancy and zones as of the end of one generation step
+ *
+ * Purpose:
+ *   - Gameplay/AI code queries cell states and zones while the generator rewrites its live grid on another thread
+ *   - Never modified after Make(), so readers need no locks and never see a half-built grid
+ *
+ * Copy-on-write:
+ *   - Cells and zones are separate shared arrays tagged with the generator revision they were copied at
+ *   - Make() reuses the previous snapshot's array when its revision is unchanged (topology-only or grid-only updates copy one array)
+ */
+struct BUILDINGGENERATOR_API FRoomGridSnapshot
+{
+	using FCellArray = TSharedRef<const TArray<EGridCellType>, ESPMode::ThreadSafe>;
+	using FZoneArray = TSharedRef<const TArray<ECellZone>, ESPMode::ThreadSafe>;
+
+	/**
+	 * Build the next snapshot, calling CopyCells / CopyZones only for arrays whose revision differs from Previous
+	 * (CopyZones may leave the array empty when topology was never analyzed) */
+	static FRoomGridSnapshotPtr Make(const FRoomGridSnapshotPtr& Previous, uint32 InVersion, FIntPoint InGridSize,
+		uint32 InGridRevision, TFunctionRef<void(TArray<EGridCellType>& OutCells)> CopyCells,
+		uint32 InTopologyRevision, TFunctionRef<void(TArray<ECellZone>& OutZones)> CopyZones);
+
+	FORCEINLINE uint32 GetVersion() const { return Version; }
+	FORCEINLINE FIntPoint GetGridSize() const { return GridSize; }
+	FORCEINLINE bool HasTopology() const { return Zones->Num() > 0; }
+	FORCEINLINE bool IsValidGridCoordinate(FIntPoint GridCoord) const
+	{
+		return GridCoord.X >= 0 && GridCoord.X < GridSize.X && GridCoord.Y >= 0 && GridCoord.Y < GridSize.Y;
+	}
+
+	/** Flat row-major cells (Index = Y * GridSize.X + X), same layout as URoomGenerator::GetGridState() */
+	FORCEINLINE const TArray<EGridCellType>& GetGridState() const { return *Cells; }
+
+	/** Cell type (ECT_Empty out of bounds, like URoomGenerator::GetCellState) */
+	EGridCellType GetCellState(FIntPoint GridCoord) const;
+
+	/** Zone of an analyzed cell (Empty for cells outside the analyzed room or without topology) */
+	ECellZone GetCellZone(FIntPoint GridCoord) const;
+
+	/** Analyzed cells of a zone in row-major order (Empty lists every cell outside the analyzed room) */
+	TArray<FIntPoint> GetCellsByZone(ECellZone Zone) const;
+
+	/** Run-length encode cells (and zones when present) for save/transfer (see GridRunLengthCodec.h) */
+	void Encode(TArray<uint8>& OutBytes) const;
+
+private:
+	FRoomGridSnapshot(uint32 InVersion, FIntPoint InGridSize, uint32 InGridRevision, FCellArray InCells, uint32 InTopologyRevision, FZoneArray InZones)
+		: Version(InVersion), GridSize(InGridSize), GridRevision(InGridRevision), TopologyRevision(InTopologyRevision)
+		, Cells(MoveTemp(InCells)), Zones(MoveTemp(InZones))
+	{
+	}
+
+	uint32 Version;
+	FIntPoint GridSize;
+	uint32 GridRevision;
+	uint32 TopologyRevision;
+	FCellArray Cells;
+	FZoneArray Zones;
+};
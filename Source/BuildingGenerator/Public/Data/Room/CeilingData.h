@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Data/Generation/RoomGenerationTypes.h"
 #include "CeilingData.generated.h"
 
 struct FMeshPlacementInfo;
@@ -17,6 +18,15 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Tiles")
 	TArray<FMeshPlacementInfo> CeilingTilePool;
+
+	/* Same strategies as the floor: Greedy runs one full-grid pass per footprint size, Hierarchical subdivides 4x4 blocks in a single pass */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Tiles")
+	EFloorTilingMode TilingMode = EFloorTilingMode::Greedy;
+
+	/* FullGrid tiles the whole bounding grid, FollowFloor only cells the floor covers (no tiles over forced empty or void cells),
+	 * MirrorFloor also copies each floor tile's footprint where the pool has a matching ceiling tile */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Tiles")
+	ECeilingCoverageMode CoverageMode = ECeilingCoverageMode::FullGrid;
 	
 	// Height of the ceiling above the floor (Z offset)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Settings")
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Data/Generation/RoomGenerationTypes.h"
 #include "FloorData.generated.h"
 
 struct FMeshPlacementInfo;
@@ -18,6 +19,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Tiles")
 	TArray<FMeshPlacementInfo> FloorTilePool;
 
+	/* Greedy runs one full-grid pass per footprint size, Hierarchical subdivides 4x4 blocks in a single pass */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Tiles")
+	EFloorTilingMode TilingMode = EFloorTilingMode::Greedy;
+
 	// --- Floor Clutter / Detail Meshes ---
 	
 	// A separate pool for smaller details or clutter placed randomly on top of the main tiles.
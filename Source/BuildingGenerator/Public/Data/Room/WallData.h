@@ -21,6 +21,12 @@ public:
 	// The default static mesh to use for the floor in the room (e.g., a simple square tile)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Defaults")
 	TSoftObjectPtr<UStaticMesh> DefaultCornerMesh; 
+
+	// Mesh for concave (inner) corners of irregular rooms, e.g. the inside of an L; DefaultCornerMesh if unset
+	// Inner corners use the rotation of the corner whose two walls meet there, with its offset mirrored in X/Y
+	// (corner offsets push out of the room; at an inner corner the room lies on the other side of the vertex)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Defaults")
+	TSoftObjectPtr<UStaticMesh> InnerCornerMesh;
 	
 	// Per-corner position offsets (clockwise from bottom-left)	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Corner Position Adjustments")
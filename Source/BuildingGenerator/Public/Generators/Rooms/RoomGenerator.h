@@ -4,11 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "Data/Grid/GridData.h"
+#include "Data/Grid/GridBitboard.h"
+#include "Data/Grid/GridChangeJournal.h"
+#include "Data/Grid/GridChunkStore.h"
+#include "Data/Grid/GridConnectivity.h"
+#include "Data/Grid/GridContour.h"
+#include "Data/Grid/GridTopologyStore.h"
+#include "Data/Grid/RoomGridSnapshot.h"
 #include "Data/Room/FloorData.h"
 #include "Data/Room/WallData.h"
 #include "Data/Room/DoorData.h"
 #include "Data/Room/CeilingData.h"
 #include "Data/Room/RoomData.h"
+#include "Generators/Rooms/RoomPlacementEngine.h"
 #include "RoomGenerator.generated.h"
 
 
@@ -31,31 +39,10 @@ protected:
 	/** Target cell type for floor placement (ECT_Empty for uniform, ECT_Custom for chunky/shaped) */
 	EGridCellType FloorTargetCellType = EGridCellType::ECT_Empty;
 	
-	TMap<FIntPoint, FCellData> CellMetadata;
+	/* Per-cell zone and wall/opening masks, filled by AnalyzeTopology */
+	FGridTopologyStore CellTopology;
 	
 #pragma region Topology Analysis Helpers
-	/**
-	 * Count occupied neighbors in 4 cardinal directions
-	 * @param Cell - Cell to check
-	 * @return Number of occupied neighbors (0-4)
-	 */
-	virtual int32 CountOccupiedNeighbors(FIntPoint Cell) const;
-
-	/**
-	 * Detect walls for a cell (directions with no occupied neighbors)
-	 * @param Cell - Cell to analyze
-	 * @param OutCellData - Cell data to populate with wall directions
-	 */
-	virtual void DetectWalls(FIntPoint Cell, FCellData& OutCellData);
-
-	/**
-	 * Classify cell zone based on neighbor count and wall configuration
-	 * @param NeighborCount - Number of occupied neighbors
-	 * @param WallDirections - Set of wall directions
-	 * @return Classified zone type
-	 */
-	virtual ECellZone ClassifyCellZone(int32 NeighborCount, const TSet<ECellDirection>& WallDirections) const;
-
 	/**
 	 * Get neighbor cell coordinate in a direction
 	 * @param Cell - Starting cell
@@ -63,11 +50,6 @@ protected:
 	 * @return Neighbor cell coordinate
 	 */
 	virtual FIntPoint GetNeighborCell(FIntPoint Cell, ECellDirection Direction) const;
-
-	/**
-	 * Check if two wall directions are adjacent (for corner detection)
-	 */
-	virtual bool AreDirectionsAdjacent(ECellDirection Dir1, ECellDirection Dir2) const;
 #pragma endregion
 public:
 #pragma region Initialization
@@ -92,10 +74,44 @@ public:
 	
 	// Grid dimensions in cells
 	FIntPoint GridSize;
+
+	// Cell order inside each storage chunk (applied by CreateGrid)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generator|Performance")
+	EGridMemoryLayout GridMemoryLayout = EGridMemoryLayout::RowMajor;
 	
-	// Grid state array (row-major order: Index = Y * GridSize.X + X)
-	UPROPERTY()
-	TArray<EGridCellType> GridState;
+	// Cell types in 16x16 chunks (chunks holding a single type are elided; CellTypeBoard and CellTopology stay dense per cell)
+	FGridChunkStore CellChunks;
+
+	// Flat row-major copy of CellChunks handed out by GetGridState() (Index = Y * GridSize.X + X, rebuilt lazily after writes)
+	mutable TArray<EGridCellType> GridStateView;
+	mutable bool bGridStateViewDirty = true;
+
+	// Bumped on every cell write (snapshots reuse their cell copy while it is unchanged)
+	uint32 GridRevision = 0;
+
+	/* Flag the flat view stale and bump GridRevision (called by every cell mutation) */
+	FORCEINLINE void MarkGridChanged() { bGridStateViewDirty = true; ++GridRevision; }
+
+	/* Grow the rect UpdateTopology re-classifies (called with every written rect once topology is analyzed) */
+	FORCEINLINE void MarkTopologyDirty(const FIntRect& Rect)
+	{
+		if (!bTopologyAnalyzed) return;
+		if (bTopologyDirty) { TopologyDirtyRect.Union(Rect); }
+		else { TopologyDirtyRect = Rect; bTopologyDirty = true; }
+	}
+
+	// Per-cell-type bit planes mirroring CellChunks (rect availability tests are per row word, not per cell),
+	// followed by the ceiling/clutter/reserved layer planes in the same allocation (see EGridLayer)
+	FGridBitboard CellTypeBoard;
+
+	// Undo log of cell writes per generation phase (reset by CreateGrid, recording from the first phase on)
+	FGridChangeJournal ChangeJournal;
+
+	// Walkable components and the doorway-reachable set (rebuilt by ValidateReachability)
+	FGridConnectivity Connectivity;
+
+	// Outline runs of the room (cells that are not WallMesh/Void), traced by GenerateWalls
+	FGridContour WallContour;
 	
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
 	void CreateGrid();
@@ -103,7 +119,7 @@ public:
 	void ClearGrid();
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
 	void ResetGridCellStates();
-	const TArray<EGridCellType>& GetGridState() const { return GridState; }
+	const TArray<EGridCellType>& GetGridState() const;
 	FIntPoint GetGridSize() const { return GridSize; }
 	float GetCellSize() const { return CellSize; }
 	EGridCellType GetCellState(FIntPoint GridCoord) const;
@@ -117,6 +133,34 @@ public:
 
 	/** Clear a rectangular area (set to Empty) * @param StartCoord - Top-left corner of area @param Size - Size of area in cells (X, Y) */
 	bool ClearArea(FIntPoint StartCoord, FIntPoint Size);
+
+	/**
+	 * Latest published snapshot (thread-safe; readers keep it as long as they like, null before the first CreateGrid)
+	 * Published at the end of CreateGrid, GenerateFloor, doorway marking and AnalyzeTopology */
+	FRoomGridSnapshotPtr GetSnapshot() const;
+
+	/* Publish the live grid and topology as a new immutable snapshot (game thread, unchanged parts are shared) */
+	void PublishSnapshot();
+
+	/* Run-length encode the live cells (plus zones once topology is analyzed) for save/transfer (see GridRunLengthCodec.h) */
+	void EncodeGridState(TArray<uint8>& OutBytes) const;
+
+	/**
+	 * Replace the cells with an encoded layout of the current grid size (re-analyzes topology if zones were saved)
+	 * @return False on malformed or mismatched data, leaving the grid untouched */
+	bool DecodeGridState(TConstArrayView<uint8> Bytes);
+
+	/** Write a rectangular area to CellChunks and CellTypeBoard (single mutation point keeping them in sync, area is clipped) */
+	void WriteCells(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType);
+
+	/** Write scattered single cells (out-of-grid and unchanged cells are skipped); dirty marking happens once for the batch
+	 * @return Cells changed */
+	int32 WriteCellList(TConstArrayView<FIntPoint> Cells, EGridCellType CellType);
+
+	/**
+	 * Undo the latest journaled section of Phase and every phase after it in O(changed cells), dropping the floor meshes they placed
+	 * @return Cells restored, INDEX_NONE if Phase was not journaled since CreateGrid */
+	int32 RollbackPhase(EGridPhase Phase);
 #pragma endregion
 
 #pragma region Floor Generation
@@ -146,9 +190,18 @@ public:
 	
 	/**
 	 * Expand forced empty regions into individual cell list
-	 * Combines rectangular regions and individual cells into unified list */
+	 * Combines rectangular regions and individual cells into unified list (deduplicated by BuildForcedEmptyMask) */
 	TArray<FIntPoint> ExpandForcedEmptyRegions() const;
 
+	/* Rasterize forced empty regions and cells into Plane of an initialized GridSize board (set = forced empty, overlaps collapse) */
+	void BuildForcedEmptyMask(FGridBitboard& OutMask, int32 Plane) const;
+
+	/* Grid rect covered by a forced empty region (corners in any order, clamped to the grid) */
+	void GetForcedEmptyRegionRect(const FForcedEmptyRegion& Region, FIntPoint& OutStart, FIntPoint& OutSize) const;
+
+	/* Mark forced empty regions as rect writes and forced empty cells one by one @return Number of distinct cells marked */
+	int32 MarkForcedEmptyAreas();
+
 	/* Mark forced empty cells as reserved (blocked from placement) */
 	void MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells);
 #pragma endregion
@@ -158,15 +211,22 @@ public:
 	UPROPERTY(EditAnywhere)
 	UWallData* WallData;
 	
-	/* Generate walls for all four edges Uses greedy bin packing (largest modules first) */
+	/* Generate walls along every outline run of the room (bounding edges, notches, courtyards) Uses greedy bin packing (largest modules first) */
 	bool GenerateWalls();
 
 	/* Get list of placed walls */
 	const TArray<FPlacedWallInfo>& GetPlacedWalls() const { return PlacedWallMeshes; }
 
+	/* Outline runs and corners walls were generated along (as of the last GenerateWalls / GenerateCorners) */
+	const FGridContour& GetWallContour() const { return WallContour; }
+
+	/* Trace WallContour over the room mask (cells that are not forced empty or void) @return false if the grid is not built */
+	bool TraceRoomOutline();
+
 	int32 ExecuteForcedWallPlacements();
 
-	bool IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const;
+	/* True if a placed base wall on the same edge and grid line overlaps [StartCell, StartCell + Length) */
+	bool IsCellRangeOccupied(EWallEdge Edge, int32 Line, int32 StartCell, int32 Length) const;
 	
 	/* Clear all placed walls */
 	void ClearPlacedWalls();
@@ -181,13 +241,16 @@ public:
 	
 #pragma region Corner Generation
 
-	/* Generate corner pieces for all 4 corners */
+	/* Generate corner pieces at every convex and concave vertex of the room outline (re-traced from the current grid) */
 	bool GenerateCorners();
 
 
-	/* Get list of placed corners */
+	/* Get list of placed corners (grouped by mesh, see GetCornerBatches) */
 	const TArray<FPlacedCornerInfo>& GetPlacedCorners() const { return PlacedCornerMeshes; }
 
+	/* Ranges of GetPlacedCorners that share a mesh, one per instanced component */
+	const TArray<FCornerMeshBatch>& GetCornerBatches() const { return CornerMeshBatches; }
+
 	/* Clear all placed corners */
 	void ClearPlacedCorners();
 
@@ -210,6 +273,9 @@ public:
 	/* Get list of placed doorways */
 	const TArray<FPlacedDoorwayInfo>& GetPlacedDoorways() const { return PlacedDoorwayMeshes; }
 
+	/* Interior cells just inside each placed doorway (doorway edge cells lie outside the grid) */
+	void GetDoorwayEntryCells(TArray<FIntPoint>& OutCells) const;
+
 	/* Clear all placed doorways */
 	void ClearPlacedDoorways();
 
@@ -232,6 +298,21 @@ public:
 	void ClearPlacedCeiling() { PlacedCeilingTiles.Empty(); }
 #pragma endregion
 	
+#pragma region Benchmarks
+	/* Time greedy vs hierarchical floor tiling on square grids from MinSize to MaxSize (results are logged) */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Benchmark")
+	void BenchmarkFloorTilers(int32 MinSize = 10, int32 MaxSize = 50, int32 Step = 10, int32 Iterations = 5);
+
+	/* Time the floor, ceiling and topology phases under each EGridMemoryLayout on square grids (results are logged) */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Benchmark")
+	void BenchmarkGridLayouts(int32 MinSize = 32, int32 MaxSize = 256, int32 Step = 32, int32 Iterations = 3);
+
+	/* Time topology analysis split into 1..MaxBands row bands on square grids from MinSize doubling up to MaxSize
+	 * (bands run on the full task pool, so this varies the band count, not the worker count; speedups over one band are logged) */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Benchmark")
+	void BenchmarkParallelTopology(int32 MinSize = 32, int32 MaxSize = 1024, int32 MaxBands = 8, int32 Iterations = 5);
+#pragma endregion
+	
 #pragma region Coordinate Conversion
 	/* Convert grid coordinates to local position (center of cell) */
 	FVector GridToLocalPosition(FIntPoint GridCoord) const;
@@ -245,9 +326,12 @@ public:
 
 #pragma region Room Statistics
 
-	/* Get count of cells by type */
+	/* Get count of cells by type (plane popcount) */
 	int32 GetCellCountByType(EGridCellType CellType) const;
 
+	/* Count of every cell type, one plane popcount per type (index = EGridCellType) */
+	void GetCellTypeHistogram(TArray<int32>& OutCounts) const;
+
 	/* Get percentage of grid occupied */
 	float GetOccupancyPercentage() const;
 
@@ -275,6 +359,10 @@ public:
 	UPROPERTY()
 	TArray<FPlacedCornerInfo> PlacedCornerMeshes;
 
+	// Per-mesh ranges of PlacedCornerMeshes
+	UPROPERTY()
+	TArray<FCornerMeshBatch> CornerMeshBatches;
+
 	// Tracked base wall segments for Middle/Top spawning
 	UPROPERTY()
 	TArray<FGeneratorWallSegment> PlacedBaseWallSegments;
@@ -302,47 +390,126 @@ public:
 #pragma endregion
 
 #pragma region private Internal Floor Generation Functions
-	/* Fill grid with tiles of specific size */
-	void FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, FIntPoint TargetSize, 
+	/* Greedy tiling: one full-grid pass per footprint (largest first), then gap fill */
+	void FillFloorGreedy(const TArray<FMeshPlacementInfo>& TilePool,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Hierarchical tiling: single pass over 4x4 blocks, each split 4x4 -> 2x4/4x2 -> 2x2 -> 1x2/2x1 -> 1x1 until a free footprint has tiles */
+	int32 FillFloorHierarchical(const TArray<FMeshPlacementInfo>& TilePool,
 	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Floor tile record for a placement (transform at floor level) */
+	FPlacedMeshInfo MakePlacedFloorMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation) const;
+
+	/* Placement engine over the room grid's free cells, appending to PlacedFloorMeshes */
+	FFloorPlacementEngine MakeFloorPlacementEngine();
 #pragma endregion
 
 #pragma region Internal Ceiling Generation Functions
-	// Ceiling generation helpers
-	void FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied, 
-	FIntPoint TargetSize, const FRotator& CeilingRotation, float CeilingHeight, int32& OutTilesPlaced);
+	/* Place RoomData's forced ceiling tiles through the ceiling engine @return Number placed */
+	int32 ExecuteForcedCeilingPlacements(FCeilingPlacementEngine& Engine);
+
+	/* Reset the ceiling layer, marking cells outside the floor mask occupied for FollowFloor/MirrorFloor coverage @return Cells marked */
+	int32 SeedCeilingCoverage(ECeilingCoverageMode Mode);
 
-	int32 FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied, const FRotator& CeilingRotation,
-	float CeilingHeight, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+	/* Place a ceiling tile over each placed floor tile whose footprint the pool can match @return Number placed */
+	int32 MirrorFloorLayout(FCeilingPlacementEngine& Engine, const TArray<FMeshPlacementInfo>& TilePool,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Ceiling tile record for a placement (centered on its footprint at CeilingHeight, CeilingRotation plus tile yaw) */
+	FPlacedCeilingInfo MakePlacedCeilingTile(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation) const;
 
-	int32 ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied);
+	/* Placement engine over CellTypeBoard's ceiling layer (set = occupied), appending to PlacedCeilingTiles */
+	FCeilingPlacementEngine MakeCeilingPlacementEngine();
 #pragma endregion
 	
 #pragma region Internal Helpers
-	/* Convert 2D grid coordinate to 1D array index */
+	/* Convert 2D grid coordinate to 1D index into GetGridState() (always row-major, storage order follows GridMemoryLayout) */
 	int32 GridCoordToIndex(FIntPoint GridCoord) const;
 
 	/* Convert 1D array index to 2D grid coordinate */
 	FIntPoint IndexToGridCoord(int32 Index) const;
 
-	/* Fill one edge with wall modules using greedy bin packing */
+	/* Fill one bounding edge with wall modules using greedy bin packing */
 	void FillWallEdge(EWallEdge Edge);
+
+	/* Fill one outline run with wall modules using greedy bin packing (doorway cells are the run's outside cells) */
+	void FillWallRun(const FGridContourRun& Run);
 #pragma region Topology Analysis	
 	/**
-	 * Analyze room topology and populate CellMetadata
+	 * Analyze room topology and populate CellTopology
 	 * Should be called after CreateGrid() and floor generation
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
 	virtual void AnalyzeTopology();
 
 	/**
-	 * Get cell metadata map (for visualization/queries)
+	 * Bring topology up to date after local edits (forced-empty toggles, placements, runtime destruction)
+	 * Only cells written since the last analysis/update and their 8-neighbour ring are re-classified, and the zone
+	 * index is patched in place; falls back to AnalyzeTopology when nothing was analyzed yet or edits cover much of the grid
+	 * Wall distances are re-swept only around the edits (FGridTopologyStore::UpdateWallDistances)
+	 * Called by the actor after floor regeneration and before drawing topology
+	 * @return Number of cells whose zone or wall mask changed (analyzed cells after a full analysis)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
+	int32 UpdateTopology();
+
+	/* True if cells were written since the last AnalyzeTopology / UpdateTopology */
+	bool IsTopologyDirty() const { return bTopologyDirty; }
+
+	/**
+	 * Get the dense per-cell topology (for visualization/queries)
+	 */
+	const FGridTopologyStore& GetCellTopology() const { return CellTopology; }
+
+	/**
+	 * Get topology data for one cell (default FCellData if out of bounds)
 	 */
 	UFUNCTION(BlueprintPure, Category = "Room Generator|Topology")
-	const TMap<FIntPoint, FCellData>& GetCellMetadata() const { return CellMetadata; }
+	FCellData GetCellData(FIntPoint Cell) const { return CellTopology.MakeCellData(Cell); }
 
 	/**
-	 * Get all cells of a specific zone type
+	 * Get metadata for every analyzed cell (built on demand from CellTopology; prefer GetCellData / zone queries)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
+	TMap<FIntPoint, FCellData> GetCellMetadata() const;
+
+	/* Allocation-free zone queries: views into the zone index built by AnalyzeTopology (valid until the next analysis) */
+	TConstArrayView<FIntPoint> GetZoneCellsView(ECellZone Zone) const { return CellTopology.GetZoneCells(Zone); }
+	TConstArrayView<FIntPoint> GetBorderCellsView() const { return CellTopology.GetBorderCells(); }
+	TConstArrayView<FIntPoint> GetCornerCellsView() const { return CellTopology.GetZoneCells(ECellZone::ExternalCorner, ECellZone::InternalCorner); }
+	TConstArrayView<FIntPoint> GetCenterCellsView() const { return CellTopology.GetZoneCells(ECellZone::Center); }
+
+	/**
+	 * Number of cells of a zone type (no allocation)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Room Generator|Topology")
+	int32 GetZoneCellCount(ECellZone Zone) const { return GetZoneCellsView(Zone).Num(); }
+
+	/**
+	 * Number of border / corner cells (no allocation)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Room Generator|Topology")
+	int32 GetBorderCellCount() const { return GetBorderCellsView().Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Room Generator|Topology")
+	int32 GetCornerCellCount() const { return GetCornerCellsView().Num(); }
+
+	/**
+	 * Steps from a cell to the nearest wall (1 = next to a wall; 0 for empty/void or out of bounds)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Room Generator|Topology")
+	int32 GetWallDistance(FIntPoint Cell) const;
+
+	/**
+	 * Analyzed cells whose wall distance is in [MinDistance, MaxDistance]
+	 * (1, 1 = one cell in from a wall; N, 255 = at least N from any wall)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
+	TArray<FIntPoint> GetCellsByWallDistance(int32 MinDistance, int32 MaxDistance) const;
+
+	/**
+	 * Get all cells of a specific zone type (copy of GetZoneCellsView)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
 	TArray<FIntPoint> GetCellsByZone(ECellZone Zone) const;
@@ -354,7 +521,7 @@ public:
 	TArray<FIntPoint> GetBorderCells() const;
 
 	/**
-	 * Get all corner cells (cells with exactly 2 adjacent walls)
+	 * Get all corner cells (external corners with 2 adjacent walls, then internal corners next to a concave notch)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
 	TArray<FIntPoint> GetCornerCells() const;
@@ -365,6 +532,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Room Generator|Topology")
 	TArray<FIntPoint> GetCenterCells() const;
 
+	/**
+	 * Label walkable cells (floor, custom, doorway) into 4-connected components and flood them from the doorways
+	 * Logs component sizes and every region no doorway reaches (run after MarkDoorwayCells)
+	 * @return Number of walkable cells no doorway reaches (0 when there are no doorways to seed from)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Room Generator|Validation")
+	int32 ValidateReachability();
+
+	/** True if the cell is walkable and connected to a doorway (as of the last ValidateReachability) */
+	UFUNCTION(BlueprintPure, Category = "Room Generator|Validation")
+	bool IsCellReachable(FIntPoint Cell) const { return Connectivity.IsReachable(Cell); }
+
+	/* Components and reachable set from the last ValidateReachability */
+	const FGridConnectivity& GetConnectivity() const { return Connectivity; }
+
 	/**
 	 * Check if topology has been analyzed
 	 */
@@ -376,4 +558,16 @@ public:
 private:
 	// Topology analysis flag
 	bool bTopologyAnalyzed = false;
+
+	// Bounding rect of cells written since topology was last analyzed/updated (valid while bTopologyDirty)
+	FIntRect TopologyDirtyRect;
+	bool bTopologyDirty = false;
+
+	// Bumped by AnalyzeTopology (snapshots reuse their zone copy while it is unchanged)
+	uint32 TopologyRevision = 0;
+
+	// Published snapshot; the lock only guards swapping/copying the pointer, never a grid read or write
+	FRoomGridSnapshotPtr PublishedSnapshot;
+	mutable FRWLock SnapshotLock;
+	uint32 SnapshotVersion = 0;
 };
\ No newline at end of file
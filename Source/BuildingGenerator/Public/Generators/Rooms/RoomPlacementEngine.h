@@ -0,0 +1,304 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Generation/RoomGenerationTypes.h"
+#include "Data/Grid/GridAnchorIndex.h"
+#include "Data/Grid/GridBitboard.h"
+#include "Data/Grid/GridChunkStore.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+class URoomGenerator;
+
+/**
+ * Placement layers - the occupancy a TRoomPlacementEngine tiles over
+ *
+ * Every layer provides:
+ *   FIntPoint GetSize() const
+ *   bool IsAreaFree(FIntPoint Start, FIntPoint Size) const    Rect inside the grid with every cell free
+ *   bool IsAreaFull(FIntPoint Start, FIntPoint Size) const    No free cell in a rect already inside the grid
+ *   void MarkArea(FIntPoint Start, FIntPoint Size)            Occupy a rect IsAreaFree accepted
+ *   void BuildAnchorIndex(FGridAnchorIndex& OutIndex, FIntPoint Footprint) const
+ *                                                             Index every anchor where Footprint is free
+ */
+
+/* FFloorPlacementLayer - The room grid's free cells (marks go through URoomGenerator::WriteCells so chunks and planes stay in sync) */
+struct BUILDINGGENERATOR_API FFloorPlacementLayer
+{
+	FFloorPlacementLayer(URoomGenerator& InGenerator, EGridCellType InFreeType, EGridCellType InMarkType);
+
+	FIntPoint GetSize() const;
+	bool IsAreaFree(FIntPoint Start, FIntPoint Size) const;
+	bool IsAreaFull(FIntPoint Start, FIntPoint Size) const;
+	void MarkArea(FIntPoint Start, FIntPoint Size);
+	void BuildAnchorIndex(FGridAnchorIndex& OutIndex, FIntPoint Footprint) const;
+
+private:
+	URoomGenerator* Generator;
+	int32 FreePlane;
+	EGridCellType MarkType;
+};
+
+/* FBitboardPlacementLayer - One plane of a standalone bitboard (set = occupied), e.g. the ceiling */
+struct BUILDINGGENERATOR_API FBitboardPlacementLayer
+{
+	/** Board must outlive the layer */
+	explicit FBitboardPlacementLayer(FGridBitboard& InBoard, int32 InPlane = 0);
+
+	FIntPoint GetSize() const { return FIntPoint(Board->GetWidth(), Board->GetHeight()); }
+	bool IsAreaFree(FIntPoint Start, FIntPoint Size) const;
+	bool IsAreaFull(FIntPoint Start, FIntPoint Size) const;
+	void MarkArea(FIntPoint Start, FIntPoint Size);
+	void BuildAnchorIndex(FGridAnchorIndex& OutIndex, FIntPoint Footprint) const { OutIndex.Build(*Board, Plane, false, Footprint); }
+
+private:
+	FGridBitboard* Board;
+	int32 Plane;
+};
+
+/* FRoomPlacement - Footprint ladders and tile-pool helpers shared by every placement engine */
+struct BUILDINGGENERATOR_API FRoomPlacement
+{
+	/** Greedy ladder, one full-grid pass per footprint: 4x4, 2x4, 4x2, 2x2, 1x2, 2x1, 1x1 */
+	static const FIntPoint GreedyLadder[7];
+
+	/** Gap-fill ladder run after the greedy passes: 1x4, 4x1, 1x2, 2x1, 1x1 */
+	static const FIntPoint GapLadder[5];
+
+	/** Every footprint the hierarchical subdivision can produce */
+	static const FIntPoint HierarchicalLadder[9];
+
+	/** Footprint in cells (explicit GridFootprint, else 1x1) */
+	static FIntPoint GetFootprint(const FMeshPlacementInfo& MeshInfo);
+
+	/** Collect pool tiles whose footprint matches TargetSize (either orientation) */
+	static void GatherTilesForFootprint(const TArray<FMeshPlacementInfo>& TilePool, FIntPoint TargetSize, TArray<FMeshPlacementInfo>& OutTiles);
+
+	/** Random allowed rotation that maps the mesh footprint onto TargetSize (0 if none does) */
+	static int32 PickRotationForFootprint(const FMeshPlacementInfo& MeshInfo, FIntPoint TargetSize);
+
+	/** Bump the large/medium/small/filler counter matching a placed footprint */
+	static void CountPlacedTile(FIntPoint Size, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+};
+
+/**
+ * TRoomPlacementEngine - Tile placement shared by every room surface
+ *
+ * Purpose:
+ *   - One implementation of forced placement, greedy footprint passes, gap fill and hierarchical block subdivision
+ *   - LayerType is the occupancy being tiled (see placement layers above), RecordType the record appended per placed tile
+ *   - Records come from a builder so each surface keeps its own transform rules (floor at Z 0, ceiling height and rotation)
+ *
+ * Footprint passes walk the layer's anchor index (placement-bound, not area-bound), other placements test rects with
+ * the layer's kernel/row-mask checks, so an optimization to a layer or to this engine applies to floors and ceilings alike
+ */
+template<typename LayerType, typename RecordType>
+class TRoomPlacementEngine
+{
+public:
+	using FRecordBuilder = TFunction<RecordType(FIntPoint Start, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)>;
+
+	TRoomPlacementEngine(LayerType InLayer, TArray<RecordType>& InRecords, FRecordBuilder InBuildRecord)
+		: Layer(MoveTemp(InLayer)), Records(InRecords), BuildRecord(MoveTemp(InBuildRecord))
+	{
+	}
+
+	LayerType& GetLayer() { return Layer; }
+
+	/** Place one tile if its rect is free @return True if placed */
+	bool TryPlace(FIntPoint Start, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+	{
+		if (!Layer.IsAreaFree(Start, Size)) return false;
+		Place(Start, Size, MeshInfo, Rotation);
+		return true;
+	}
+
+	/** Place a weighted pick from MatchingTiles on a given rect if it is free @return True if placed */
+	bool TryPlaceWeighted(const TArray<FMeshPlacementInfo>& MatchingTiles, FIntPoint Start, FIntPoint Size)
+	{
+		if (MatchingTiles.Num() == 0 || !Layer.IsAreaFree(Start, Size)) return false;
+		PlaceWeighted(MatchingTiles, Start, Size);
+		return true;
+	}
+
+	/**
+	 * Place a designer-forced tile with the first rotation (in order, none = 0°) whose rotated footprint fits
+	 * @return Rotation used, INDEX_NONE if no rotation fits */
+	int32 TryPlaceForced(FIntPoint Start, const FMeshPlacementInfo& MeshInfo, TConstArrayView<int32> Rotations, FIntPoint& OutFootprint)
+	{
+		static const int32 DefaultRotation = 0;
+		const TConstArrayView<int32> RotationsToTry = Rotations.Num() > 0 ? Rotations : MakeArrayView(&DefaultRotation, 1);
+		const FIntPoint OriginalFootprint = FRoomPlacement::GetFootprint(MeshInfo);
+
+		for (int32 Rotation : RotationsToTry)
+		{
+			const FIntPoint RotatedFootprint = URoomGenerationHelpers::GetRotatedFootprint(OriginalFootprint, Rotation);
+			if (TryPlace(Start, RotatedFootprint, MeshInfo, Rotation))
+			{
+				OutFootprint = RotatedFootprint;
+				return Rotation;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * One row-major pass over every anchor where a single footprint fits, placing a weighted pick at each
+	 * (anchors come from the layer's anchor index, trimmed after every placement) @return Tiles placed */
+	int32 FillFootprint(const TArray<FMeshPlacementInfo>& MatchingTiles, FIntPoint TargetSize,
+		int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+	{
+		Layer.BuildAnchorIndex(AnchorIndex, TargetSize);
+
+		int32 PlacedCount = 0;
+		const FIntPoint GridSize = Layer.GetSize();
+		for (int32 Y = 0; Y + TargetSize.Y <= GridSize.Y; ++Y)
+		{
+			for (int32 X = AnchorIndex.FindNextAnchor(Y, 0); X != INDEX_NONE; X = AnchorIndex.FindNextAnchor(Y, X + TargetSize.X))
+			{
+				const FIntPoint StartCoord(X, Y);
+				checkSlow(Layer.IsAreaFree(StartCoord, TargetSize));
+
+				PlaceWeighted(MatchingTiles, StartCoord, TargetSize);
+				AnchorIndex.RemoveRect(StartCoord, TargetSize);
+				FRoomPlacement::CountPlacedTile(TargetSize, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+				PlacedCount++;
+			}
+		}
+		return PlacedCount;
+	}
+
+	/** FillFootprint for each footprint of Ladder in order (footprints without matching tiles are skipped) @return Tiles placed */
+	int32 FillLadder(const TArray<FMeshPlacementInfo>& TilePool, TConstArrayView<FIntPoint> Ladder,
+		int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+	{
+		int32 PlacedCount = 0;
+		for (const FIntPoint& TargetSize : Ladder)
+		{
+			TArray<FMeshPlacementInfo> MatchingTiles;
+			FRoomPlacement::GatherTilesForFootprint(TilePool, TargetSize, MatchingTiles);
+			if (MatchingTiles.Num() == 0) continue;
+
+			const int32 SizePlacedCount = FillFootprint(MatchingTiles, TargetSize, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+			if (SizePlacedCount > 0)
+			{
+				UE_LOG(LogTemp, Verbose, TEXT("    Placed %d %dx%d tiles (%d options)"), SizePlacedCount, TargetSize.X, TargetSize.Y, MatchingTiles.Num());
+			}
+			PlacedCount += SizePlacedCount;
+		}
+		return PlacedCount;
+	}
+
+	/**
+	 * Single pass over 4x4 blocks, each split 4x4 -> 2x4/4x2 -> 2x2 -> 1x2/2x1 -> 1x1 until a free footprint has tiles
+	 * (16x16 regions without a free cell are skipped whole, edge blocks are clipped to the grid) @return Tiles placed */
+	int32 FillHierarchical(const TArray<FMeshPlacementInfo>& TilePool,
+		int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+	{
+		TMap<FIntPoint, TArray<FMeshPlacementInfo>> TilesByFootprint;
+		for (const FIntPoint& Footprint : FRoomPlacement::HierarchicalLadder)
+		{
+			TArray<FMeshPlacementInfo> MatchingTiles;
+			FRoomPlacement::GatherTilesForFootprint(TilePool, Footprint, MatchingTiles);
+			if (MatchingTiles.Num() > 0) { TilesByFootprint.Add(Footprint, MoveTemp(MatchingTiles)); }
+		}
+		if (TilesByFootprint.Num() == 0) return 0;
+
+		const int32 PlacedBefore = Records.Num();
+		const FIntPoint GridSize = Layer.GetSize();
+		constexpr int32 RegionSize = FGridChunkStore::ChunkSize;
+		for (int32 RegionY = 0; RegionY < GridSize.Y; RegionY += RegionSize)
+		{
+			for (int32 RegionX = 0; RegionX < GridSize.X; RegionX += RegionSize)
+			{
+				const FIntPoint RegionExtent(FMath::Min(RegionSize, GridSize.X - RegionX), FMath::Min(RegionSize, GridSize.Y - RegionY));
+				if (Layer.IsAreaFull(FIntPoint(RegionX, RegionY), RegionExtent)) continue;
+
+				for (int32 BlockY = RegionY; BlockY < RegionY + RegionExtent.Y; BlockY += 4)
+				{
+					for (int32 BlockX = RegionX; BlockX < RegionX + RegionExtent.X; BlockX += 4)
+					{
+						const FIntPoint BlockSize(FMath::Min(4, GridSize.X - BlockX), FMath::Min(4, GridSize.Y - BlockY));
+						TileBlock(TilesByFootprint, FIntPoint(BlockX, BlockY), BlockSize, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+					}
+				}
+			}
+		}
+		return Records.Num() - PlacedBefore;
+	}
+
+private:
+	/** Mark and record a tile on a rect already checked free */
+	void Place(FIntPoint Start, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+	{
+		Layer.MarkArea(Start, Size);
+		Records.Add(BuildRecord(Start, Size, MeshInfo, Rotation));
+	}
+
+	/** Weighted pick from Tiles with a rotation mapping it onto Size, placed on a rect already checked free */
+	void PlaceWeighted(const TArray<FMeshPlacementInfo>& Tiles, FIntPoint Start, FIntPoint Size)
+	{
+		const FMeshPlacementInfo* Selected = URoomGenerationHelpers::SelectWeightedMeshPlacement(Tiles);
+		const FMeshPlacementInfo SelectedMesh = Selected ? *Selected : FMeshPlacementInfo();
+		Place(Start, Size, SelectedMesh, FRoomPlacement::PickRotationForFootprint(SelectedMesh, Size));
+	}
+
+	/** Tile one block of the hierarchical pass (recursive) */
+	void TileBlock(const TMap<FIntPoint, TArray<FMeshPlacementInfo>>& TilesByFootprint, FIntPoint StartCoord, FIntPoint BlockSize,
+		int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+	{
+		// Whole block free and the pool has this footprint: one tile covers it
+		const TArray<FMeshPlacementInfo>* BlockTiles = TilesByFootprint.Find(BlockSize);
+		if (BlockTiles && Layer.IsAreaFree(StartCoord, BlockSize))
+		{
+			PlaceWeighted(*BlockTiles, StartCoord, BlockSize);
+			FRoomPlacement::CountPlacedTile(BlockSize, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+			return;
+		}
+
+		// Nothing left to place below a single cell or in a fully blocked block
+		if (BlockSize.X * BlockSize.Y == 1 || Layer.IsAreaFull(StartCoord, BlockSize)) return;
+
+		// Split the longer axis; square blocks prefer the split whose halves can each take one tile (X split on ties, like greedy's 2x4 before 4x2)
+		bool bSplitX = BlockSize.X > BlockSize.Y;
+		if (BlockSize.X == BlockSize.Y)
+		{
+			auto CountWholeHalves = [&](FIntPoint HalfSize, FIntPoint SecondStart) -> int32
+			{
+				if (!TilesByFootprint.Contains(HalfSize)) return 0;
+				return (Layer.IsAreaFree(StartCoord, HalfSize) ? 1 : 0) + (Layer.IsAreaFree(SecondStart, HalfSize) ? 1 : 0);
+			};
+			const int32 Half = BlockSize.X / 2;
+			const int32 WholeX = CountWholeHalves(FIntPoint(Half, BlockSize.Y), FIntPoint(StartCoord.X + Half, StartCoord.Y));
+			const int32 WholeY = CountWholeHalves(FIntPoint(BlockSize.X, Half), FIntPoint(StartCoord.X, StartCoord.Y + Half));
+			bSplitX = WholeX >= WholeY;
+		}
+
+		if (bSplitX)
+		{
+			const int32 FirstX = (BlockSize.X + 1) / 2;
+			TileBlock(TilesByFootprint, StartCoord, FIntPoint(FirstX, BlockSize.Y), OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+			TileBlock(TilesByFootprint, FIntPoint(StartCoord.X + FirstX, StartCoord.Y), FIntPoint(BlockSize.X - FirstX, BlockSize.Y),
+				OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+		}
+		else
+		{
+			const int32 FirstY = (BlockSize.Y + 1) / 2;
+			TileBlock(TilesByFootprint, StartCoord, FIntPoint(BlockSize.X, FirstY), OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+			TileBlock(TilesByFootprint, FIntPoint(StartCoord.X, StartCoord.Y + FirstY), FIntPoint(BlockSize.X, BlockSize.Y - FirstY),
+				OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+		}
+	}
+
+	LayerType Layer;
+	TArray<RecordType>& Records;
+	FRecordBuilder BuildRecord;
+
+	/** Anchor plane of the footprint pass in progress (storage reused across passes) */
+	FGridAnchorIndex AnchorIndex;
+};
+
+/* Engines used by URoomGenerator */
+using FFloorPlacementEngine = TRoomPlacementEngine<FFloorPlacementLayer, FPlacedMeshInfo>;
+using FCeilingPlacementEngine = TRoomPlacementEngine<FBitboardPlacementLayer, FPlacedCeilingInfo>;
@@ -43,6 +43,10 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (ClampMin = "4", ClampMax = "50"))
 	FIntPoint RoomGridSize = FIntPoint(10, 10);
+
+	/* Cell order inside the generator's storage chunks (see BenchmarkGridLayouts) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", AdvancedDisplay)
+	EGridMemoryLayout GridMemoryLayout = EGridMemoryLayout::RowMajor;
 #pragma endregion
 
 #pragma region Editor Functions
@@ -136,6 +140,20 @@ public:
 	void RefreshVisualization();
 #pragma endregion
 	
+#pragma region Benchmarks
+	/* Log greedy vs hierarchical floor tiling timings for 10x10 through 50x50 grids using this room's FloorData */
+	UFUNCTION(CallInEditor, Category = "Room Generation|Benchmark")
+	void BenchmarkFloorTilers();
+
+	/* Log floor/ceiling/topology timings for each grid memory layout on 32x32 through 256x256 grids using this room's data */
+	UFUNCTION(CallInEditor, Category = "Room Generation|Benchmark")
+	void BenchmarkGridLayouts();
+
+	/* Log topology timings for 1 through 8 row bands (band count, not worker count) on 32x32 through 1024x1024 grids */
+	UFUNCTION(CallInEditor, Category = "Room Generation|Benchmark")
+	void BenchmarkParallelTopology();
+#pragma endregion
+	
 #endif
 #pragma endregion
 	
@@ -95,9 +95,9 @@ public:
 #pragma region Advanced Debug Drawing
 	/**
 	 * Draw wall direction indicators (arrows showing N/E/S/W walls)
-	 * Requires: CellMetadata with WallDirections populated
+	 * Requires: CellTopology populated by AnalyzeTopology
 	 */
-	void DrawWallIndicators(const TMap<FIntPoint, struct FCellData>& CellMetadata, float CellSize, FVector OriginLocation);
+	void DrawWallIndicators(const struct FGridTopologyStore& CellTopology, float CellSize, FVector OriginLocation);
 
 	/**
 	 * Draw room center marker (sphere + RGB axes)
@@ -6,6 +6,7 @@
 #include "Data/Generation/RoomGenerationTypes.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Data/Grid/GridData.h"
+#include "Data/Grid/GridBitboard.h"
 #include "RoomGenerationHelpers.generated.h"
 
 UCLASS()
@@ -58,6 +59,12 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation|Grid")
 	static bool TryPlaceMeshInGrid(TArray<EGridCellType>& GridState, FIntPoint GridSize, FIntPoint StartCoord,
 	FIntPoint Size,	EGridCellType TargetCellType, EGridCellType PlacementType = EGridCellType::ECT_FloorMesh);
+
+	/** Bitboard variant of IsAreaAvailable - one mask test per row word instead of one compare per cell
+	* @param Board - Cell type bitboard mirroring the grid @param StartCoord - Top-left corner to check
+	* @param Size - Size of area in cells @param RequiredType - Cell type required @return True if entire area is available */
+	static bool IsAreaAvailableInBitboard(const FGridBitboard& Board, FIntPoint StartCoord, FIntPoint Size,
+	EGridCellType RequiredType = EGridCellType::ECT_Empty);
 #pragma endregion
 
 #pragma region Rotation & Footprint Operations
@@ -87,6 +94,24 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	static FVector CalculateWallPosition( EWallEdge Edge, int32 StartCell, int32 SpanLength, FIntPoint GridSize, float CellSize,
 	float NorthOffset, float SouthOffset, float EastOffset, float WestOffset);
 
+	/** Calculate world position for a wall segment standing on any grid line facing the same way as Edge
+	* @param Line - Grid line index (X line for North/South edges, Y line for East/West; the bounding edge is GetEdgeLine)
+	* Other params as CalculateWallPosition @return World position for the wall */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Walls")
+	static FVector CalculateWallPositionOnLine(EWallEdge Edge, int32 Line, int32 StartCell, int32 SpanLength, float CellSize,
+	float NorthOffset, float SouthOffset, float EastOffset, float WestOffset);
+
+	/* Grid line of a bounding edge (GridSize.X for North, 0 for South, GridSize.Y for East, 0 for West) */
+	static int32 GetEdgeLine(EWallEdge Edge, FIntPoint GridSize);
+
+	/* Wall edge facing the same way as a cell side (grid +X side is the North edge, +Y side the East edge) */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Walls")
+	static EWallEdge GetWallEdgeForSide(ECellDirection Side);
+
+	/* Corner where the walls of an East/West cell side and a North/South cell side meet (e.g. West + South sides = SouthWest) */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Walls")
+	static ECornerPosition GetCornerPositionForSides(ECellDirection SideAlongY, ECellDirection SideAlongX);
+
 	/* Calculate doorway center position (for frame/actor placement) */
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Doorways")
 	static FVector CalculateDoorwayPosition(EWallEdge Edge, int32 StartCell, 